@@ -0,0 +1,85 @@
+/*
+    AtomTable.h
+    ===========
+        Class AtomTable header.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <iostream>
+#include <Eigen/Dense>
+#include "Predecl.h"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::ostream;
+using Eigen::MatrixX3d;
+using Eigen::VectorXi;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Class AtomTable
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class AtomTable
+{
+    // Friend
+    friend ostream &operator<<(ostream &os, const AtomTable &atomTableObj);
+    friend class Selection;
+
+
+public:
+
+    // Constructor
+    explicit AtomTable(const vector<Atom *> &atomPtrList);
+
+
+    // Getter: __atomPtrList
+    const vector<Atom *> &atomPtrList() const;
+
+
+    // Getter: __coordMatrix
+    const MatrixX3d &coordMatrix() const;
+
+
+    // Size
+    int size() const;
+
+
+    // Update (Reload Coords From The Atoms)
+    AtomTable *update();
+
+
+private:
+
+    // Data
+    vector<Atom *> __atomPtrList;
+    MatrixX3d __coordMatrix;
+    VectorXi __resNumList;
+    VectorXi __chainCodeList;
+    VectorXi __resNameCodeList;
+    VectorXi __nameCodeList;
+    VectorXi __eleCodeList;
+    unordered_map<string, int> __chainCodeMap;
+    unordered_map<string, int> __resNameCodeMap;
+    unordered_map<string, int> __nameCodeMap;
+    unordered_map<string, int> __eleCodeMap;
+
+
+    // str
+    string __str() const;
+};
+
+
+}  // End namespace PDBTools
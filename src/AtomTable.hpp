@@ -0,0 +1,136 @@
+/*
+    AtomTable.hpp
+    =============
+        Class AtomTable implementation.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <boost/format.hpp>
+#include <Eigen/Dense>
+#include "AtomTable.h"
+#include "Chain.h"
+#include "Residue.h"
+#include "Atom.h"
+#include "Util.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using boost::format;
+using Eigen::MatrixX3d;
+using Eigen::VectorXi;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+AtomTable::AtomTable(const vector<Atom *> &atomPtrList):
+    __atomPtrList(atomPtrList),
+    __coordMatrix(atomPtrList.size(), 3),
+    __resNumList(atomPtrList.size()),
+    __chainCodeList(atomPtrList.size()),
+    __resNameCodeList(atomPtrList.size()),
+    __nameCodeList(atomPtrList.size()),
+    __eleCodeList(atomPtrList.size())
+{
+    // Dictionary Encoding: Each Distinct String Is Hashed Here Once, Selections Compare Codes
+    auto encodeFunc = [](unordered_map<string, int> &codeMap, const string &valStr)
+    {
+        auto codeIter = codeMap.find(valStr);
+
+        if (codeIter == codeMap.end())
+        {
+            codeIter = codeMap.emplace(valStr, codeMap.size()).first;
+        }
+
+        return codeIter->second;
+    };
+
+    for (int atomIdx = 0; atomIdx < (int) atomPtrList.size(); atomIdx++)
+    {
+        auto atomPtr = atomPtrList[atomIdx];
+        auto resPtr  = atomPtr->owner();
+
+        string chainName = resPtr && resPtr->owner() ? resPtr->owner()->name() : "";
+
+        __coordMatrix.row(atomIdx) = atomPtr->coord();
+        __resNumList[atomIdx]      = resPtr ? resPtr->num() : 0;
+        __chainCodeList[atomIdx]   = encodeFunc(__chainCodeMap, chainName);
+        __resNameCodeList[atomIdx] = encodeFunc(__resNameCodeMap, resPtr ? resPtr->name() : "");
+        __nameCodeList[atomIdx]    = encodeFunc(__nameCodeMap, atomPtr->name());
+        __eleCodeList[atomIdx]     = encodeFunc(__eleCodeMap, getElement(atomPtr));
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __atomPtrList
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const vector<Atom *> &AtomTable::atomPtrList() const
+{
+    return __atomPtrList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __coordMatrix
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const MatrixX3d &AtomTable::coordMatrix() const
+{
+    return __coordMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Size
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int AtomTable::size() const
+{
+    return __atomPtrList.size();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Update (Reload Coords From The Atoms)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+AtomTable *AtomTable::update()
+{
+    for (int atomIdx = 0; atomIdx < (int) __atomPtrList.size(); atomIdx++)
+    {
+        __coordMatrix.row(atomIdx) = __atomPtrList[atomIdx]->coord();
+    }
+
+    return this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// str
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string AtomTable::__str() const
+{
+    return (format("<AtomTable object: %d atoms, at %p>") %
+        __atomPtrList.size()                              %
+        this
+    ).str();
+}
+
+
+}  // End namespace PDBTools
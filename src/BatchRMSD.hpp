@@ -0,0 +1,205 @@
+/*
+    BatchRMSD.hpp
+    =============
+        Batch RMSD functions implementation.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+#include <boost/format.hpp>
+#include <Eigen/Dense>
+#include "Math.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::vector;
+using std::min;
+using std::max;
+using std::pair;
+using std::runtime_error;
+using boost::format;
+using Eigen::RowVector3d;
+using Eigen::Matrix3d;
+using Eigen::MatrixX3d;
+using Eigen::VectorXd;
+using Eigen::MatrixXd;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Batch Tile Size (Models Per Scheduling Block)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const int __BATCH_RMSD_TILE_SIZE = 32;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Check Coord Matrix List Size (Every Model Must Have atomNum Rows)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void __checkCoordMatrixListSize(const vector<MatrixX3d> &coordMatrixList, int atomNum)
+{
+    for (int modelIdx = 0; modelIdx < (int) coordMatrixList.size(); modelIdx++)
+    {
+        if (coordMatrixList[modelIdx].rows() != atomNum)
+        {
+            throw runtime_error((format("Coord matrix size mismatch: model %d has %d atoms, expected %d") %
+                modelIdx % coordMatrixList[modelIdx].rows() % atomNum).str());
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Center Coord Matrix List
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+pair<vector<MatrixX3d>, VectorXd> __centerCoordMatrixList(const vector<MatrixX3d> &coordMatrixList)
+{
+    int modelNum = coordMatrixList.size();
+
+    vector<MatrixX3d> centerCoordMatrixList(modelNum);
+    VectorXd innerProductList(modelNum);
+
+    #pragma omp parallel for schedule(static)
+    for (int modelIdx = 0; modelIdx < modelNum; modelIdx++)
+    {
+        centerCoordMatrixList[modelIdx] = coordMatrixList[modelIdx].rowwise() -
+            coordMatrixList[modelIdx].colwise().mean();
+
+        innerProductList[modelIdx] = centerCoordMatrixList[modelIdx].squaredNorm();
+    }
+
+    return {centerCoordMatrixList, innerProductList};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// For Each RMSD Pair (All-vs-All, Tiled, i < j)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Func>
+void __forEachRMSDPair(const vector<MatrixX3d> &coordMatrixList, Func &&pairFunc)
+{
+    if (!coordMatrixList.empty())
+    {
+        __checkCoordMatrixListSize(coordMatrixList, coordMatrixList[0].rows());
+    }
+
+    auto [centerCoordMatrixList, innerProductList] = __centerCoordMatrixList(coordMatrixList);
+
+    int modelNum = coordMatrixList.size();
+    int tileNum  = (modelNum + __BATCH_RMSD_TILE_SIZE - 1) / __BATCH_RMSD_TILE_SIZE;
+
+    vector<pair<int, int>> tilePairList;
+
+    for (int tileIdxI = 0; tileIdxI < tileNum; tileIdxI++)
+    {
+        for (int tileIdxJ = tileIdxI; tileIdxJ < tileNum; tileIdxJ++)
+        {
+            tilePairList.emplace_back(tileIdxI, tileIdxJ);
+        }
+    }
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int tilePairIdx = 0; tilePairIdx < (int) tilePairList.size(); tilePairIdx++)
+    {
+        auto [tileIdxI, tileIdxJ] = tilePairList[tilePairIdx];
+
+        int startIdxI = tileIdxI * __BATCH_RMSD_TILE_SIZE, endIdxI = min(startIdxI + __BATCH_RMSD_TILE_SIZE, modelNum);
+        int startIdxJ = tileIdxJ * __BATCH_RMSD_TILE_SIZE, endIdxJ = min(startIdxJ + __BATCH_RMSD_TILE_SIZE, modelNum);
+
+        for (int modelIdxI = startIdxI; modelIdxI < endIdxI; modelIdxI++)
+        {
+            for (int modelIdxJ = max(startIdxJ, modelIdxI + 1); modelIdxJ < endIdxJ; modelIdxJ++)
+            {
+                Matrix3d covMatrix = centerCoordMatrixList[modelIdxJ].transpose().lazyProduct(centerCoordMatrixList[modelIdxI]);
+
+                pairFunc(modelIdxI, modelIdxJ, calcRMSDByQCP(innerProductList[modelIdxI],
+                    innerProductList[modelIdxJ], covMatrix, centerCoordMatrixList[modelIdxI].rows()));
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc RMSD List After Superimpose (One-vs-Many)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorXd calcRMSDListAfterSuperimpose(const MatrixX3d &tarCoordMatrix, const vector<MatrixX3d> &srcCoordMatrixList)
+{
+    __checkCoordMatrixListSize(srcCoordMatrixList, tarCoordMatrix.rows());
+
+    int modelNum = srcCoordMatrixList.size();
+
+    MatrixX3d tarCenterCoordMatrix = tarCoordMatrix.rowwise() - tarCoordMatrix.colwise().mean();
+    double tarInnerProduct = tarCenterCoordMatrix.squaredNorm();
+
+    VectorXd rmsdList(modelNum);
+
+    #pragma omp parallel for schedule(static)
+    for (int modelIdx = 0; modelIdx < modelNum; modelIdx++)
+    {
+        RowVector3d srcCenterCoord = srcCoordMatrixList[modelIdx].colwise().mean();
+
+        // Columns Of The Centered Target Sum To Zero, So The Source Needs No Centering Here
+        Matrix3d covMatrix = srcCoordMatrixList[modelIdx].transpose().lazyProduct(tarCenterCoordMatrix);
+
+        double srcInnerProduct = srcCoordMatrixList[modelIdx].squaredNorm() -
+            tarCoordMatrix.rows() * srcCenterCoord.squaredNorm();
+
+        rmsdList[modelIdx] = calcRMSDByQCP(tarInnerProduct, srcInnerProduct, covMatrix, tarCoordMatrix.rows());
+    }
+
+    return rmsdList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc RMSD Matrix After Superimpose (All-vs-All, Dense)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MatrixXd calcRMSDMatrixAfterSuperimpose(const vector<MatrixX3d> &coordMatrixList)
+{
+    MatrixXd rmsdMatrix = MatrixXd::Zero(coordMatrixList.size(), coordMatrixList.size());
+
+    __forEachRMSDPair(coordMatrixList, [&](int modelIdxI, int modelIdxJ, double rmsdValue)
+    {
+        rmsdMatrix(modelIdxI, modelIdxJ) = rmsdValue;
+        rmsdMatrix(modelIdxJ, modelIdxI) = rmsdValue;
+    });
+
+    return rmsdMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Condensed RMSD Matrix After Superimpose (All-vs-All, Upper Triangle)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorXd calcCondensedRMSDMatrixAfterSuperimpose(const vector<MatrixX3d> &coordMatrixList)
+{
+    long modelNum = coordMatrixList.size();
+
+    VectorXd rmsdList(modelNum * (modelNum - 1) / 2);
+
+    __forEachRMSDPair(coordMatrixList, [&](long modelIdxI, long modelIdxJ, double rmsdValue)
+    {
+        rmsdList[modelNum * modelIdxI - modelIdxI * (modelIdxI + 1) / 2 + modelIdxJ - modelIdxI - 1] = rmsdValue;
+    });
+
+    return rmsdList;
+}
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,118 @@
+/*
+    CellList.h
+    ==========
+        Class CellList header.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <Eigen/Dense>
+#include "Predecl.h"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::pair;
+using std::ostream;
+using Eigen::RowVector3d;
+using Eigen::MatrixX3d;
+using Eigen::Array3i;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Class CellList
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class CellList
+{
+    // Friend
+    friend ostream &operator<<(ostream &os, const CellList &cellListObj);
+
+
+public:
+
+    // Constructor
+    CellList(const MatrixX3d &coordMatrix, double cellSize);
+
+
+    // Constructor (Atom List)
+    CellList(const vector<Atom *> &atomPtrList, double cellSize);
+
+
+    // Getter: __coordMatrix
+    const MatrixX3d &coordMatrix() const;
+
+
+    // Getter: __cellSize
+    double cellSize() const;
+
+
+    // Size
+    int size() const;
+
+
+    // Query Radius
+    vector<int> queryRadius(const RowVector3d &coord, double radius) const;
+
+
+    // For Each Pair
+    template <typename Func>
+    void forEachPair(double cutoff, Func &&pairFunc) const;
+
+
+    // Get Pairs
+    vector<pair<int, int>> getPairs(double cutoff) const;
+
+
+    // Update
+    CellList *update(int atomIdx, const RowVector3d &coord);
+
+
+    // Update (Atom Idx List)
+    CellList *update(const vector<int> &atomIdxList, const MatrixX3d &coordMatrix);
+
+
+private:
+
+    // Data
+    double __cellSize;
+    RowVector3d __minCoord;
+    Array3i __cellNum;
+    MatrixX3d __coordMatrix;
+    vector<int> __atomCellIdxList;
+    vector<vector<int>> __cellAtomIdxList;
+
+
+    // Calc Cell Coord
+    Array3i __calcCellCoord(const RowVector3d &coord) const;
+
+
+    // Calc Cell Idx
+    int __calcCellIdx(const Array3i &cellCoord) const;
+
+
+    // Calc Neighbor Offset List
+    vector<Array3i> __calcNeighborOffsetList(double cutoff) const;
+
+
+    // For Each Pair In Cell
+    template <typename Func>
+    void __forEachPairInCell(int cellIdx, const vector<Array3i> &offsetList, double cutoff, Func &&pairFunc) const;
+
+
+    // str
+    string __str() const;
+};
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,404 @@
+/*
+    CellList.hpp
+    ============
+        Class CellList implementation.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <boost/format.hpp>
+#include <Eigen/Dense>
+#include "CellList.h"
+#include "Atom.h"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::pair;
+using std::min;
+using std::max;
+using std::find;
+using std::floor;
+using std::ceil;
+using std::cbrt;
+using std::sqrt;
+using std::runtime_error;
+using boost::format;
+using Eigen::RowVector3d;
+using Eigen::MatrixX3d;
+using Eigen::Array3i;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Max Cell Num Per Atom (Cell Size Is Enlarged For Sparse Bounding Boxes)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const double __CELL_LIST_MAX_CELL_NUM_PER_ATOM = 8.;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+CellList::CellList(const MatrixX3d &coordMatrix, double cellSize):
+    __cellSize(cellSize),
+    __coordMatrix(coordMatrix)
+{
+    if (!(cellSize > 0.))
+    {
+        throw runtime_error((format("Invalid cell size: %f") % cellSize).str());
+    }
+
+    if (coordMatrix.rows() == 0)
+    {
+        __minCoord.setZero();
+        __cellNum.setOnes();
+    }
+    else
+    {
+        __minCoord = coordMatrix.colwise().minCoeff();
+
+        RowVector3d boxSize = coordMatrix.colwise().maxCoeff() - __minCoord;
+        double maxCellNum = max(__CELL_LIST_MAX_CELL_NUM_PER_ATOM * coordMatrix.rows(), 1.);
+        double cellNum = ((boxSize.array() / __cellSize).floor() + 1.).prod();
+
+        if (cellNum > maxCellNum)
+        {
+            __cellSize *= cbrt(cellNum / maxCellNum);
+        }
+
+        __cellNum = ((boxSize.array() / __cellSize).floor() + 1.).cast<int>();
+    }
+
+    __cellAtomIdxList.resize(__cellNum.prod());
+    __atomCellIdxList.resize(coordMatrix.rows());
+
+    for (int atomIdx = 0; atomIdx < coordMatrix.rows(); atomIdx++)
+    {
+        int cellIdx = __calcCellIdx(__calcCellCoord(coordMatrix.row(atomIdx)));
+
+        __atomCellIdxList[atomIdx] = cellIdx;
+        __cellAtomIdxList[cellIdx].push_back(atomIdx);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor (Atom List)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+CellList::CellList(const vector<Atom *> &atomPtrList, double cellSize):
+    CellList(
+        [&atomPtrList]()
+        {
+            MatrixX3d coordMatrix(atomPtrList.size(), 3);
+
+            for (int idx = 0; idx < (int) atomPtrList.size(); idx++)
+            {
+                coordMatrix.row(idx) = atomPtrList[idx]->coord();
+            }
+
+            return coordMatrix;
+        }(),
+        cellSize) {}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __coordMatrix
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const MatrixX3d &CellList::coordMatrix() const
+{
+    return __coordMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __cellSize
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double CellList::cellSize() const
+{
+    return __cellSize;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Size
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int CellList::size() const
+{
+    return __coordMatrix.rows();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Query Radius
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<int> CellList::queryRadius(const RowVector3d &coord, double radius) const
+{
+    Array3i minCellCoord = __calcCellCoord(coord.array() - radius);
+    Array3i maxCellCoord = __calcCellCoord(coord.array() + radius);
+
+    double squaredRadius = radius * radius;
+    vector<int> atomIdxList;
+
+    for (int cellX = minCellCoord[0]; cellX <= maxCellCoord[0]; cellX++)
+    {
+        for (int cellY = minCellCoord[1]; cellY <= maxCellCoord[1]; cellY++)
+        {
+            for (int cellZ = minCellCoord[2]; cellZ <= maxCellCoord[2]; cellZ++)
+            {
+                for (int atomIdx: __cellAtomIdxList[__calcCellIdx(Array3i(cellX, cellY, cellZ))])
+                {
+                    if ((__coordMatrix.row(atomIdx) - coord).squaredNorm() <= squaredRadius)
+                    {
+                        atomIdxList.push_back(atomIdx);
+                    }
+                }
+            }
+        }
+    }
+
+    return atomIdxList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// For Each Pair
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Func>
+void CellList::forEachPair(double cutoff, Func &&pairFunc) const
+{
+    auto offsetList = __calcNeighborOffsetList(cutoff);
+
+    for (int cellIdx = 0; cellIdx < (int) __cellAtomIdxList.size(); cellIdx++)
+    {
+        __forEachPairInCell(cellIdx, offsetList, cutoff, pairFunc);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Pairs
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<pair<int, int>> CellList::getPairs(double cutoff) const
+{
+    auto offsetList = __calcNeighborOffsetList(cutoff);
+    int slabCellNum = __cellNum[1] * __cellNum[2];
+
+    // One Pair List Per X Slab, So That Slabs Can Be Scanned In Parallel
+    vector<vector<pair<int, int>>> slabPairList(__cellNum[0]);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int cellX = 0; cellX < __cellNum[0]; cellX++)
+    {
+        for (int cellIdx = cellX * slabCellNum; cellIdx < (cellX + 1) * slabCellNum; cellIdx++)
+        {
+            __forEachPairInCell(cellIdx, offsetList, cutoff, [&](int atomIdxI, int atomIdxJ, double)
+            {
+                slabPairList[cellX].emplace_back(atomIdxI, atomIdxJ);
+            });
+        }
+    }
+
+    vector<pair<int, int>> pairList;
+
+    for (auto &cellXPairList: slabPairList)
+    {
+        pairList.insert(pairList.end(), cellXPairList.begin(), cellXPairList.end());
+    }
+
+    return pairList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Update
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+CellList *CellList::update(int atomIdx, const RowVector3d &coord)
+{
+    __coordMatrix.row(atomIdx) = coord;
+
+    int oldCellIdx = __atomCellIdxList[atomIdx];
+    int newCellIdx = __calcCellIdx(__calcCellCoord(coord));
+
+    if (oldCellIdx != newCellIdx)
+    {
+        auto &oldCellAtomIdxList = __cellAtomIdxList[oldCellIdx];
+
+        *find(oldCellAtomIdxList.begin(), oldCellAtomIdxList.end(), atomIdx) = oldCellAtomIdxList.back();
+        oldCellAtomIdxList.pop_back();
+
+        __cellAtomIdxList[newCellIdx].push_back(atomIdx);
+        __atomCellIdxList[atomIdx] = newCellIdx;
+    }
+
+    return this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Update (Atom Idx List)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+CellList *CellList::update(const vector<int> &atomIdxList, const MatrixX3d &coordMatrix)
+{
+    for (int idx = 0; idx < (int) atomIdxList.size(); idx++)
+    {
+        update(atomIdxList[idx], coordMatrix.row(idx));
+    }
+
+    return this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Cell Coord (Clamped, So Atoms Outside The Initial Box Fall Into The Boundary Cells)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Array3i CellList::__calcCellCoord(const RowVector3d &coord) const
+{
+    return ((coord - __minCoord).array() / __cellSize).floor().max(0.).min(
+        (__cellNum - 1).cast<double>().transpose()).cast<int>().transpose();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Cell Idx
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int CellList::__calcCellIdx(const Array3i &cellCoord) const
+{
+    return (cellCoord[0] * __cellNum[1] + cellCoord[1]) * __cellNum[2] + cellCoord[2];
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Neighbor Offset List (Half Shell)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<Array3i> CellList::__calcNeighborOffsetList(double cutoff) const
+{
+    Array3i shellSize = Array3i::Constant(ceil(cutoff / __cellSize)).min(__cellNum - 1);
+    vector<Array3i> offsetList;
+
+    for (int offsetX = 0; offsetX <= shellSize[0]; offsetX++)
+    {
+        for (int offsetY = -shellSize[1]; offsetY <= shellSize[1]; offsetY++)
+        {
+            for (int offsetZ = -shellSize[2]; offsetZ <= shellSize[2]; offsetZ++)
+            {
+                if (offsetX == 0 && (offsetY < 0 || (offsetY == 0 && offsetZ <= 0)))
+                {
+                    continue;
+                }
+
+                Array3i offsetCoord(offsetX, offsetY, offsetZ);
+
+                // Skip Cells Whose Nearest Corner Is Already Beyond The Cutoff
+                if (((offsetCoord.abs() - 1).max(0).cast<double>() * __cellSize).matrix().squaredNorm() <=
+                    cutoff * cutoff)
+                {
+                    offsetList.push_back(offsetCoord);
+                }
+            }
+        }
+    }
+
+    return offsetList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// For Each Pair In Cell
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Func>
+void CellList::__forEachPairInCell(int cellIdx, const vector<Array3i> &offsetList, double cutoff,
+    Func &&pairFunc) const
+{
+    const auto &cellAtomIdxList = __cellAtomIdxList[cellIdx];
+
+    if (cellAtomIdxList.empty())
+    {
+        return;
+    }
+
+    double squaredCutoff = cutoff * cutoff;
+
+    auto checkFunc = [&](int atomIdxI, int atomIdxJ)
+    {
+        double squaredDis = (__coordMatrix.row(atomIdxI) - __coordMatrix.row(atomIdxJ)).squaredNorm();
+
+        if (squaredDis <= squaredCutoff)
+        {
+            pairFunc(min(atomIdxI, atomIdxJ), max(atomIdxI, atomIdxJ), sqrt(squaredDis));
+        }
+    };
+
+    for (int idxI = 0; idxI < (int) cellAtomIdxList.size(); idxI++)
+    {
+        for (int idxJ = idxI + 1; idxJ < (int) cellAtomIdxList.size(); idxJ++)
+        {
+            checkFunc(cellAtomIdxList[idxI], cellAtomIdxList[idxJ]);
+        }
+    }
+
+    Array3i cellCoord(cellIdx / (__cellNum[1] * __cellNum[2]), cellIdx / __cellNum[2] % __cellNum[1],
+        cellIdx % __cellNum[2]);
+
+    for (auto &offsetCoord: offsetList)
+    {
+        Array3i neighborCellCoord = cellCoord + offsetCoord;
+
+        if ((neighborCellCoord < 0).any() || (neighborCellCoord >= __cellNum).any())
+        {
+            continue;
+        }
+
+        for (int atomIdxJ: __cellAtomIdxList[__calcCellIdx(neighborCellCoord)])
+        {
+            for (int atomIdxI: cellAtomIdxList)
+            {
+                checkFunc(atomIdxI, atomIdxJ);
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// str
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string CellList::__str() const
+{
+    return (format("<CellList object: %d atoms, %d * %d * %d cells, at %p>") %
+        __coordMatrix.rows()                                               %
+        __cellNum[0]                                                       %
+        __cellNum[1]                                                       %
+        __cellNum[2]                                                       %
+        this
+    ).str();
+}
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,105 @@
+/*
+    ClashChecker.h
+    ==============
+        Class ClashChecker header.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <iostream>
+#include <Eigen/Dense>
+#include "Predecl.h"
+#include "PairExclusion.h"
+#include "CellList.h"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::pair;
+using std::ostream;
+using Eigen::VectorXd;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Class ClashChecker
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ClashChecker
+{
+    // Friend
+    friend ostream &operator<<(ostream &os, const ClashChecker &clashCheckerObj);
+
+
+public:
+
+    // Constructor
+    explicit ClashChecker(const vector<Atom *> &atomPtrList, double overlapCutoff = 0.4);
+
+
+    // Has Clash
+    bool hasClash() const;
+
+
+    // Has Clash (Moved Atoms vs The Rest)
+    bool hasClash(const vector<Atom *> &movedAtomPtrList);
+
+
+    // Get Clashes
+    vector<pair<Atom *, Atom *>> getClashes() const;
+
+
+    // Get Clashes (Moved Atoms vs The Rest)
+    vector<pair<Atom *, Atom *>> getClashes(const vector<Atom *> &movedAtomPtrList);
+
+
+    // Update
+    ClashChecker *update();
+
+
+    // Update (Moved Atoms)
+    ClashChecker *update(const vector<Atom *> &movedAtomPtrList);
+
+
+private:
+
+    // Data
+    vector<Atom *> __atomPtrList;
+    unordered_map<Atom *, int> __atomIdxMap;
+    __PairExclusion __pairExclusion;
+    VectorXd __radiusList;
+    double __overlapCutoff;
+    double __searchRadius;
+    CellList __cellList;
+    vector<bool> __movedBoolList;
+
+
+    // Is Clash Pair
+    bool __isClashPair(int atomIdxI, int atomIdxJ) const;
+
+
+    // Search Clashes
+    template <typename Func>
+    void __searchClashes(const vector<int> &queryIdxList, bool movedBool, Func &&clashFunc) const;
+
+
+    // Get Moved Idx List
+    vector<int> __getMovedIdxList(const vector<Atom *> &movedAtomPtrList);
+
+
+    // str
+    string __str() const;
+};
+
+
+}  // End namespace PDBTools
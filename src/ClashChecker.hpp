@@ -0,0 +1,273 @@
+/*
+    ClashChecker.hpp
+    ================
+        Class ClashChecker implementation.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <boost/format.hpp>
+#include <Eigen/Dense>
+#include "ClashChecker.h"
+#include "Atom.h"
+#include "PairExclusion.hpp"
+#include "CellList.hpp"
+#include "Util.hpp"
+#include "Constants.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::pair;
+using boost::format;
+using Eigen::VectorXd;
+using Eigen::MatrixX3d;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ClashChecker::ClashChecker(const vector<Atom *> &atomPtrList, double overlapCutoff):
+    __atomPtrList(atomPtrList),
+    __pairExclusion(atomPtrList),
+    __radiusList(atomPtrList.size()),
+    __overlapCutoff(overlapCutoff),
+    __searchRadius(0.),
+    __cellList(atomPtrList, 2. * __DEFAULT_VDW_RADIUS),
+    __movedBoolList(atomPtrList.size())
+{
+    for (int atomIdx = 0; atomIdx < (int) atomPtrList.size(); atomIdx++)
+    {
+        auto atomPtr = atomPtrList[atomIdx];
+
+        __atomIdxMap[atomPtr] = atomIdx;
+        __radiusList[atomIdx] = getVdwRadius(atomPtr);
+    }
+
+    if (!atomPtrList.empty())
+    {
+        __searchRadius = 2. * __radiusList.maxCoeff() - __overlapCutoff;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Has Clash
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ClashChecker::hasClash() const
+{
+    vector<int> queryIdxList(__atomPtrList.size());
+
+    for (int atomIdx = 0; atomIdx < (int) queryIdxList.size(); atomIdx++)
+    {
+        queryIdxList[atomIdx] = atomIdx;
+    }
+
+    bool clashBool = false;
+
+    __searchClashes(queryIdxList, false, [&](int, int)
+    {
+        clashBool = true;
+        return true;
+    });
+
+    return clashBool;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Has Clash (Moved Atoms vs The Rest)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ClashChecker::hasClash(const vector<Atom *> &movedAtomPtrList)
+{
+    auto movedIdxList = __getMovedIdxList(movedAtomPtrList);
+
+    bool clashBool = false;
+
+    __searchClashes(movedIdxList, true, [&](int, int)
+    {
+        clashBool = true;
+        return true;
+    });
+
+    for (int atomIdx: movedIdxList)
+    {
+        __movedBoolList[atomIdx] = false;
+    }
+
+    return clashBool;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Clashes
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<pair<Atom *, Atom *>> ClashChecker::getClashes() const
+{
+    vector<int> queryIdxList(__atomPtrList.size());
+
+    for (int atomIdx = 0; atomIdx < (int) queryIdxList.size(); atomIdx++)
+    {
+        queryIdxList[atomIdx] = atomIdx;
+    }
+
+    vector<pair<Atom *, Atom *>> clashList;
+
+    __searchClashes(queryIdxList, false, [&](int atomIdxI, int atomIdxJ)
+    {
+        clashList.emplace_back(__atomPtrList[atomIdxI], __atomPtrList[atomIdxJ]);
+        return false;
+    });
+
+    return clashList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Clashes (Moved Atoms vs The Rest)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<pair<Atom *, Atom *>> ClashChecker::getClashes(const vector<Atom *> &movedAtomPtrList)
+{
+    auto movedIdxList = __getMovedIdxList(movedAtomPtrList);
+
+    vector<pair<Atom *, Atom *>> clashList;
+
+    __searchClashes(movedIdxList, true, [&](int atomIdxI, int atomIdxJ)
+    {
+        clashList.emplace_back(__atomPtrList[atomIdxI], __atomPtrList[atomIdxJ]);
+        return false;
+    });
+
+    for (int atomIdx: movedIdxList)
+    {
+        __movedBoolList[atomIdx] = false;
+    }
+
+    return clashList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Update
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ClashChecker *ClashChecker::update()
+{
+    for (int atomIdx = 0; atomIdx < (int) __atomPtrList.size(); atomIdx++)
+    {
+        __cellList.update(atomIdx, __atomPtrList[atomIdx]->coord());
+    }
+
+    return this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Update (Moved Atoms)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ClashChecker *ClashChecker::update(const vector<Atom *> &movedAtomPtrList)
+{
+    for (int atomIdx: __getMovedIdxList(movedAtomPtrList))
+    {
+        __movedBoolList[atomIdx] = false;
+    }
+
+    return this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Is Clash Pair
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ClashChecker::__isClashPair(int atomIdxI, int atomIdxJ) const
+{
+    double minDis = __radiusList[atomIdxI] + __radiusList[atomIdxJ] - __overlapCutoff;
+
+    return (__cellList.coordMatrix().row(atomIdxI) - __cellList.coordMatrix().row(atomIdxJ)).squaredNorm() <
+        minDis * minDis && !__pairExclusion.isExcludedPair(atomIdxI, atomIdxJ) &&
+        !__pairExclusion.is14Pair(atomIdxI, atomIdxJ);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Search Clashes (clashFunc Returns true To Stop)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Func>
+void ClashChecker::__searchClashes(const vector<int> &queryIdxList, bool movedBool, Func &&clashFunc) const
+{
+    for (int atomIdxI: queryIdxList)
+    {
+        for (int atomIdxJ: __cellList.queryRadius(__cellList.coordMatrix().row(atomIdxI), __searchRadius))
+        {
+            // Moved Atoms Only Against Static Atoms; Otherwise Each Pair Once
+            if (movedBool ? __movedBoolList[atomIdxJ] : atomIdxJ <= atomIdxI)
+            {
+                continue;
+            }
+
+            if (__isClashPair(atomIdxI, atomIdxJ) && clashFunc(atomIdxI, atomIdxJ))
+            {
+                return;
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Moved Idx List (Also Syncs The Moved Atoms Into The Cell List)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<int> ClashChecker::__getMovedIdxList(const vector<Atom *> &movedAtomPtrList)
+{
+    vector<int> movedIdxList;
+
+    for (int atomIdx: __getAtomIdxList(__atomIdxMap, movedAtomPtrList, "ClashChecker"))
+    {
+        if (!__movedBoolList[atomIdx])
+        {
+            __movedBoolList[atomIdx] = true;
+            __cellList.update(atomIdx, __atomPtrList[atomIdx]->coord());
+            movedIdxList.push_back(atomIdx);
+        }
+    }
+
+    return movedIdxList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// str
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string ClashChecker::__str() const
+{
+    return (format("<ClashChecker object: %d atoms, at %p>") %
+        __atomPtrList.size()                                 %
+        this
+    ).str();
+}
+
+
+}  // End namespace PDBTools
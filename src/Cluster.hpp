@@ -0,0 +1,455 @@
+/*
+    Cluster.hpp
+    ===========
+        RMSD clustering functions implementation.
+*/
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <Eigen/Dense>
+#include "Math.hpp"
+#include "BatchRMSD.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::vector;
+using std::pair;
+using std::min;
+using std::max;
+using std::abs;
+using std::sort;
+using std::iota;
+using Eigen::Matrix3d;
+using Eigen::MatrixX3d;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+using Eigen::ArrayXd;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Cluster Constants
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const int __CLUSTER_PIVOT_NUM  = 8;
+const int __CLUSTER_BLOCK_SIZE = 256;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Cluster RMSD Cache (Centered Coords And Inner Products, RMSD On Demand)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct __ClusterRMSDCache
+{
+    vector<MatrixX3d> centerCoordMatrixList;
+    VectorXd innerProductList;
+    MatrixXd pivotDisMatrix;
+
+
+    // Calc RMSD
+    double calcRMSD(int modelIdxI, int modelIdxJ) const
+    {
+        if (modelIdxI == modelIdxJ)
+        {
+            return 0.;
+        }
+
+        Matrix3d covMatrix = centerCoordMatrixList[modelIdxJ].transpose().lazyProduct(
+            centerCoordMatrixList[modelIdxI]);
+
+        return calcRMSDByQCP(innerProductList[modelIdxI], innerProductList[modelIdxJ], covMatrix,
+            centerCoordMatrixList[modelIdxI].rows());
+    }
+
+
+    // Lower Bound Of The RMSD By The Triangle Inequality Through Every Pivot
+    double calcLowerBound(int modelIdxI, int modelIdxJ) const
+    {
+        return (pivotDisMatrix.row(modelIdxI) - pivotDisMatrix.row(modelIdxJ)).cwiseAbs().maxCoeff();
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Build Cluster RMSD Cache (Pivots By Farthest-First Traversal)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+__ClusterRMSDCache __buildClusterRMSDCache(const vector<MatrixX3d> &coordMatrixList)
+{
+    auto [centerCoordMatrixList, innerProductList] = __centerCoordMatrixList(coordMatrixList);
+
+    int modelNum = coordMatrixList.size(), pivotNum = min(modelNum, __CLUSTER_PIVOT_NUM);
+
+    __ClusterRMSDCache cacheObj {centerCoordMatrixList, innerProductList, MatrixXd(modelNum, pivotNum)};
+
+    VectorXd minPivotDisList = VectorXd::Constant(modelNum, INFINITY);
+
+    for (int pivotIdx = 0, modelIdxP = 0; pivotIdx < pivotNum; pivotIdx++)
+    {
+        #pragma omp parallel for schedule(static)
+        for (int modelIdx = 0; modelIdx < modelNum; modelIdx++)
+        {
+            cacheObj.pivotDisMatrix(modelIdx, pivotIdx) = cacheObj.calcRMSD(modelIdxP, modelIdx);
+        }
+
+        minPivotDisList = minPivotDisList.cwiseMin(cacheObj.pivotDisMatrix.col(pivotIdx));
+        minPivotDisList.maxCoeff(&modelIdxP);
+    }
+
+    return cacheObj;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Find Medoid (Triangle Lower Bounds Through The Current Medoid, Early Abandon On Partial Sums)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int __findMedoid(const __ClusterRMSDCache &cacheObj, const vector<int> &memberIdxList, int medoidIdx,
+    const ArrayXd &medoidDisList)
+{
+    int memberNum = memberIdxList.size();
+
+    double minDisSum = medoidDisList.sum();
+
+    // sum |d(x, m) - d(y, m)| <= sum d(x, y): Candidates In Increasing Lower Bound Order
+    vector<pair<double, int>> lowerBoundList(memberNum);
+
+    #pragma omp parallel for schedule(static)
+    for (int memberIdx = 0; memberIdx < memberNum; memberIdx++)
+    {
+        lowerBoundList[memberIdx] = {(medoidDisList - medoidDisList[memberIdx]).abs().sum(), memberIdx};
+    }
+
+    sort(lowerBoundList.begin(), lowerBoundList.end());
+
+    for (auto [lowerBound, memberIdxY]: lowerBoundList)
+    {
+        if (lowerBound >= minDisSum)
+        {
+            break;
+        }
+
+        int modelIdxY = memberIdxList[memberIdxY];
+
+        if (modelIdxY == medoidIdx)
+        {
+            continue;
+        }
+
+        double disSum = 0.;
+
+        for (int startIdx = 0; startIdx < memberNum && disSum < minDisSum; startIdx += __CLUSTER_BLOCK_SIZE)
+        {
+            int endIdx = min(startIdx + __CLUSTER_BLOCK_SIZE, memberNum);
+
+            #pragma omp parallel for schedule(static) reduction(+: disSum)
+            for (int memberIdx = startIdx; memberIdx < endIdx; memberIdx++)
+            {
+                disSum += cacheObj.calcRMSD(modelIdxY, memberIdxList[memberIdx]);
+            }
+        }
+
+        if (disSum < minDisSum)
+        {
+            minDisSum = disSum;
+            medoidIdx = modelIdxY;
+        }
+    }
+
+    return medoidIdx;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Find Cluster Medoids
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<int> __findClusterMedoids(const __ClusterRMSDCache &cacheObj, const vector<int> &labelList,
+    const vector<int> &medoidIdxList)
+{
+    vector<vector<int>> memberIdxListList(medoidIdxList.size());
+
+    for (int modelIdx = 0; modelIdx < (int) labelList.size(); modelIdx++)
+    {
+        memberIdxListList[labelList[modelIdx]].push_back(modelIdx);
+    }
+
+    vector<int> newMedoidIdxList(medoidIdxList.size());
+
+    for (int clusterIdx = 0; clusterIdx < (int) medoidIdxList.size(); clusterIdx++)
+    {
+        auto &memberIdxList = memberIdxListList[clusterIdx];
+
+        ArrayXd medoidDisList(memberIdxList.size());
+
+        #pragma omp parallel for schedule(static)
+        for (int memberIdx = 0; memberIdx < (int) memberIdxList.size(); memberIdx++)
+        {
+            medoidDisList[memberIdx] = cacheObj.calcRMSD(medoidIdxList[clusterIdx], memberIdxList[memberIdx]);
+        }
+
+        newMedoidIdxList[clusterIdx] = __findMedoid(cacheObj, memberIdxList, medoidIdxList[clusterIdx],
+            medoidDisList);
+    }
+
+    return newMedoidIdxList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Leader Clusters (Greedy: First Center Within The Cutoff, Or A New Center)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+pair<vector<int>, vector<int>> calcLeaderClusters(const vector<MatrixX3d> &coordMatrixList, double rmsdCutoff)
+{
+    int modelNum = coordMatrixList.size();
+
+    vector<int> centerIdxList, labelList(modelNum, -1);
+
+    if (modelNum == 0)
+    {
+        return {centerIdxList, labelList};
+    }
+
+    auto cacheObj = __buildClusterRMSDCache(coordMatrixList);
+
+    auto assignFunc = [&](int modelIdx, int startClusterIdx, int endClusterIdx)
+    {
+        for (int clusterIdx = startClusterIdx; clusterIdx < endClusterIdx; clusterIdx++)
+        {
+            if (cacheObj.calcLowerBound(modelIdx, centerIdxList[clusterIdx]) < rmsdCutoff &&
+                cacheObj.calcRMSD(centerIdxList[clusterIdx], modelIdx) < rmsdCutoff)
+            {
+                labelList[modelIdx] = clusterIdx;
+                break;
+            }
+        }
+    };
+
+    for (int startIdx = 0; startIdx < modelNum; startIdx += __CLUSTER_BLOCK_SIZE)
+    {
+        int endIdx = min(startIdx + __CLUSTER_BLOCK_SIZE, modelNum), oldCenterNum = centerIdxList.size();
+
+        // Centers From Earlier Blocks Are Fixed, So The Block Checks Them In Parallel
+        #pragma omp parallel for schedule(dynamic)
+        for (int modelIdx = startIdx; modelIdx < endIdx; modelIdx++)
+        {
+            assignFunc(modelIdx, 0, oldCenterNum);
+        }
+
+        // Centers Created Inside The Block, In Input Order
+        for (int modelIdx = startIdx; modelIdx < endIdx; modelIdx++)
+        {
+            if (labelList[modelIdx] < 0)
+            {
+                assignFunc(modelIdx, oldCenterNum, centerIdxList.size());
+            }
+
+            if (labelList[modelIdx] < 0)
+            {
+                labelList[modelIdx] = centerIdxList.size();
+                centerIdxList.push_back(modelIdx);
+            }
+        }
+    }
+
+    return {centerIdxList, labelList};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc K-Medoids Clusters (Farthest-First Init, Voronoi Iteration)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+pair<vector<int>, vector<int>> calcKMedoidsClusters(const vector<MatrixX3d> &coordMatrixList, int clusterNum,
+    int maxIter = 100)
+{
+    int modelNum = coordMatrixList.size();
+
+    clusterNum = min(clusterNum, modelNum);
+
+    vector<int> medoidIdxList, labelList(modelNum, 0);
+
+    if (clusterNum <= 0)
+    {
+        return {medoidIdxList, labelList};
+    }
+
+    auto cacheObj = __buildClusterRMSDCache(coordMatrixList);
+
+    VectorXd disList = VectorXd::Constant(modelNum, INFINITY);
+
+    for (int clusterIdx = 0, modelIdxM = 0; clusterIdx < clusterNum; clusterIdx++)
+    {
+        medoidIdxList.push_back(modelIdxM);
+
+        #pragma omp parallel for schedule(static)
+        for (int modelIdx = 0; modelIdx < modelNum; modelIdx++)
+        {
+            double rmsdValue = cacheObj.calcRMSD(modelIdxM, modelIdx);
+
+            if (rmsdValue < disList[modelIdx])
+            {
+                disList[modelIdx]   = rmsdValue;
+                labelList[modelIdx] = clusterIdx;
+            }
+        }
+
+        disList.maxCoeff(&modelIdxM);
+    }
+
+    for (int iterIdx = 0; iterIdx < maxIter; iterIdx++)
+    {
+        auto newMedoidIdxList = __findClusterMedoids(cacheObj, labelList, medoidIdxList);
+
+        if (newMedoidIdxList == medoidIdxList)
+        {
+            break;
+        }
+
+        medoidIdxList = newMedoidIdxList;
+
+        MatrixXd medoidDisMatrix(clusterNum, clusterNum);
+
+        #pragma omp parallel for schedule(static)
+        for (int clusterIdx = 0; clusterIdx < clusterNum * clusterNum; clusterIdx++)
+        {
+            medoidDisMatrix(clusterIdx / clusterNum, clusterIdx % clusterNum) = cacheObj.calcRMSD(
+                medoidIdxList[clusterIdx / clusterNum], medoidIdxList[clusterIdx % clusterNum]);
+        }
+
+        // Skip Medoid c When d(a, c) >= 2 d(x, a): Then d(x, c) >= d(x, a) By The Triangle Inequality
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (int modelIdx = 0; modelIdx < modelNum; modelIdx++)
+        {
+            disList[modelIdx] = cacheObj.calcRMSD(medoidIdxList[labelList[modelIdx]], modelIdx);
+
+            for (int clusterIdx = 0; clusterIdx < clusterNum; clusterIdx++)
+            {
+                if (clusterIdx == labelList[modelIdx] ||
+                    medoidDisMatrix(labelList[modelIdx], clusterIdx) >= 2. * disList[modelIdx] ||
+                    cacheObj.calcLowerBound(modelIdx, medoidIdxList[clusterIdx]) >= disList[modelIdx])
+                {
+                    continue;
+                }
+
+                double rmsdValue = cacheObj.calcRMSD(medoidIdxList[clusterIdx], modelIdx);
+
+                if (rmsdValue < disList[modelIdx])
+                {
+                    disList[modelIdx]   = rmsdValue;
+                    labelList[modelIdx] = clusterIdx;
+                }
+            }
+        }
+    }
+
+    return {medoidIdxList, labelList};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Hierarchical Clusters (Single Linkage Cut At rmsdCutoff, Centers Are Medoids)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+pair<vector<int>, vector<int>> calcHierarchicalClusters(const vector<MatrixX3d> &coordMatrixList, double rmsdCutoff)
+{
+    int modelNum = coordMatrixList.size();
+
+    vector<int> medoidIdxList, labelList(modelNum, -1);
+
+    if (modelNum == 0)
+    {
+        return {medoidIdxList, labelList};
+    }
+
+    auto cacheObj = __buildClusterRMSDCache(coordMatrixList);
+
+    vector<int> parentIdxList(modelNum);
+
+    iota(parentIdxList.begin(), parentIdxList.end(), 0);
+
+    auto findFunc = [&](int modelIdx)
+    {
+        while (parentIdxList[modelIdx] != modelIdx)
+        {
+            modelIdx = parentIdxList[modelIdx] = parentIdxList[parentIdxList[modelIdx]];
+        }
+
+        return modelIdx;
+    };
+
+    // Sorted By The First Pivot Distance, Partners Of x Lie In A Window Of Width rmsdCutoff
+    vector<pair<double, int>> pivotDisList(modelNum);
+
+    for (int modelIdx = 0; modelIdx < modelNum; modelIdx++)
+    {
+        pivotDisList[modelIdx] = {cacheObj.pivotDisMatrix(modelIdx, 0), modelIdx};
+    }
+
+    sort(pivotDisList.begin(), pivotDisList.end());
+
+    for (int sortIdxI = 0; sortIdxI < modelNum; sortIdxI++)
+    {
+        int modelIdxI = pivotDisList[sortIdxI].second;
+
+        // Pairs Already Linked Through Other Members Need No RMSD
+        vector<int> candidateIdxList;
+
+        for (int sortIdxJ = sortIdxI + 1; sortIdxJ < modelNum &&
+            pivotDisList[sortIdxJ].first - pivotDisList[sortIdxI].first < rmsdCutoff; sortIdxJ++)
+        {
+            int modelIdxJ = pivotDisList[sortIdxJ].second;
+
+            if (findFunc(modelIdxI) != findFunc(modelIdxJ) &&
+                cacheObj.calcLowerBound(modelIdxI, modelIdxJ) < rmsdCutoff)
+            {
+                candidateIdxList.push_back(modelIdxJ);
+            }
+        }
+
+        vector<char> linkBoolList(candidateIdxList.size());
+
+        #pragma omp parallel for schedule(static)
+        for (int candidateIdx = 0; candidateIdx < (int) candidateIdxList.size(); candidateIdx++)
+        {
+            linkBoolList[candidateIdx] = cacheObj.calcRMSD(modelIdxI, candidateIdxList[candidateIdx]) < rmsdCutoff;
+        }
+
+        for (int candidateIdx = 0; candidateIdx < (int) candidateIdxList.size(); candidateIdx++)
+        {
+            if (linkBoolList[candidateIdx])
+            {
+                parentIdxList[findFunc(candidateIdxList[candidateIdx])] = findFunc(modelIdxI);
+            }
+        }
+    }
+
+    // Clusters Numbered By Their Lowest Model Index, Which Also Seeds The Medoid Search
+    for (int modelIdx = 0; modelIdx < modelNum; modelIdx++)
+    {
+        int rootIdx = findFunc(modelIdx);
+
+        if (labelList[rootIdx] < 0)
+        {
+            labelList[rootIdx] = medoidIdxList.size();
+            medoidIdxList.push_back(modelIdx);
+        }
+
+        labelList[modelIdx] = labelList[rootIdx];
+    }
+
+    return {__findClusterMedoids(cacheObj, labelList, medoidIdxList), labelList};
+}
+
+
+}  // End namespace PDBTools
@@ -8,7 +8,9 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include <utility>
 
 namespace PDBTools
 {
@@ -19,7 +21,9 @@ namespace PDBTools
 
 using std::string;
 using std::unordered_map;
+using std::unordered_set;
 using std::vector;
+using std::pair;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -215,4 +219,134 @@ const unordered_map<string, vector<vector<string>>>
 };
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Residue Symmetric Atoms Name (Each Flip Swaps All Its Atom Pairs Together)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const unordered_map<string, vector<vector<pair<string, string>>>>
+    __RESIDUE_SYMMETRIC_ATOMS_NAME_MAP
+{
+    {"ARG", {
+        {{"NH1", "NH2"}},
+    }},
+
+    {"ASP", {
+        {{"OD1", "OD2"}},
+    }},
+
+    {"GLU", {
+        {{"OE1", "OE2"}},
+    }},
+
+    {"PHE", {
+        {{"CD1", "CD2"}, {"CE1", "CE2"}},
+    }},
+
+    {"TYR", {
+        {{"CD1", "CD2"}, {"CE1", "CE2"}},
+    }},
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Element => Van Der Waals Radius (Bondi)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const unordered_map<string, double> ELEMENT_VDW_RADIUS_MAP
+{
+    {"H",  1.20},
+    {"C",  1.70},
+    {"N",  1.55},
+    {"O",  1.52},
+    {"F",  1.47},
+    {"P",  1.80},
+    {"S",  1.80},
+    {"CL", 1.75},
+    {"SE", 1.90},
+    {"BR", 1.85},
+    {"I",  1.98},
+    {"NA", 2.27},
+    {"MG", 1.73},
+    {"K",  2.75},
+    {"ZN", 1.39},
+    {"CU", 1.40},
+    {"NI", 1.63},
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Default Van Der Waals Radius (Unknown Element)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const double __DEFAULT_VDW_RADIUS = 1.70;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Element => Lennard-Jones Parameters (Rmin / 2, Epsilon (kcal/mol), AMBER-Like)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const unordered_map<string, pair<double, double>> ELEMENT_LJ_PARAM_MAP
+{
+    {"H",  {1.000, 0.0157}},
+    {"C",  {1.908, 0.0860}},
+    {"N",  {1.824, 0.1700}},
+    {"O",  {1.661, 0.2100}},
+    {"F",  {1.750, 0.0610}},
+    {"P",  {2.100, 0.2000}},
+    {"S",  {2.000, 0.2500}},
+    {"CL", {1.948, 0.2650}},
+    {"SE", {2.100, 0.2910}},
+    {"BR", {2.220, 0.3200}},
+    {"I",  {2.350, 0.4000}},
+    {"NA", {1.369, 0.0874}},
+    {"MG", {0.795, 0.8750}},
+    {"K",  {1.705, 0.1937}},
+    {"ZN", {1.100, 0.0125}},
+    {"CU", {1.200, 0.0500}},
+    {"NI", {1.200, 0.0500}},
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Default Lennard-Jones Parameters (Unknown Element)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const pair<double, double> __DEFAULT_LJ_PARAM {1.908, 0.0860};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Residue Name => Atom Name => Partial Charge ("*": Any Residue, Simplified Heavy Atom Charges)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const unordered_map<string, unordered_map<string, double>> RESIDUE_ATOM_CHARGE_MAP
+{
+    {"*", {
+        {"C", 0.50}, {"O", -0.50}, {"OXT", -0.50},
+    }},
+
+    {"ARG", {
+        {"NH1", 0.50}, {"NH2", 0.50},
+    }},
+
+    {"ASP", {
+        {"OD1", -0.50}, {"OD2", -0.50},
+    }},
+
+    {"GLU", {
+        {"OE1", -0.50}, {"OE2", -0.50},
+    }},
+
+    {"LYS", {
+        {"NZ", 1.00},
+    }},
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Backbone Atoms Name
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const unordered_set<string> __BACKBONE_ATOM_NAME_SET {"N", "CA", "C", "O", "OXT"};
+
+
 }  // End namespace PDBTools
@@ -0,0 +1,356 @@
+/*
+    ContactMap.hpp
+    ==============
+        Distance matrix and contact map functions implementation.
+*/
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <boost/dynamic_bitset.hpp>
+#include <Eigen/Dense>
+#include "Residue.h"
+#include "Atom.h"
+#include "CellList.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::vector;
+using std::pair;
+using std::min;
+using std::numeric_limits;
+using std::sqrt;
+using boost::dynamic_bitset;
+using Eigen::Matrix;
+using Eigen::Dynamic;
+using Eigen::MatrixX3d;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+using Eigen::Ref;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Distance Tile Size (Rows And Columns Per Block)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const int __DISTANCE_TILE_SIZE = 128;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Squared Distance Tile
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MatrixXd __calcSquaredDistanceTile(const Ref<const MatrixX3d> &coordMatrixA, const Ref<const MatrixX3d> &coordMatrixB)
+{
+    MatrixXd squaredDisMatrix(coordMatrixA.rows(), coordMatrixB.rows());
+
+    // Coordinate Differences Rather Than |a|^2 + |b|^2 - 2ab, Which Loses Precision For Close Pairs
+    for (int idxB = 0; idxB < coordMatrixB.rows(); idxB++)
+    {
+        squaredDisMatrix.col(idxB) =
+            (coordMatrixA.col(0).array() - coordMatrixB(idxB, 0)).square() +
+            (coordMatrixA.col(1).array() - coordMatrixB(idxB, 1)).square() +
+            (coordMatrixA.col(2).array() - coordMatrixB(idxB, 2)).square();
+    }
+
+    return squaredDisMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// For Each Distance Tile
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Func>
+void __forEachDistanceTile(const MatrixX3d &coordMatrixA, const MatrixX3d &coordMatrixB, bool symmetricBool,
+    Func &&tileFunc)
+{
+    int tileNumA = (coordMatrixA.rows() + __DISTANCE_TILE_SIZE - 1) / __DISTANCE_TILE_SIZE;
+    int tileNumB = (coordMatrixB.rows() + __DISTANCE_TILE_SIZE - 1) / __DISTANCE_TILE_SIZE;
+
+    vector<pair<int, int>> tilePairList;
+
+    for (int tileIdxA = 0; tileIdxA < tileNumA; tileIdxA++)
+    {
+        for (int tileIdxB = symmetricBool ? tileIdxA : 0; tileIdxB < tileNumB; tileIdxB++)
+        {
+            tilePairList.emplace_back(tileIdxA, tileIdxB);
+        }
+    }
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int tilePairIdx = 0; tilePairIdx < (int) tilePairList.size(); tilePairIdx++)
+    {
+        auto [tileIdxA, tileIdxB] = tilePairList[tilePairIdx];
+
+        int startIdxA = tileIdxA * __DISTANCE_TILE_SIZE;
+        int startIdxB = tileIdxB * __DISTANCE_TILE_SIZE;
+        int rowNumA   = min(__DISTANCE_TILE_SIZE, int(coordMatrixA.rows()) - startIdxA);
+        int rowNumB   = min(__DISTANCE_TILE_SIZE, int(coordMatrixB.rows()) - startIdxB);
+
+        tileFunc(startIdxA, startIdxB, __calcSquaredDistanceTile(
+            coordMatrixA.middleRows(startIdxA, rowNumA), coordMatrixB.middleRows(startIdxB, rowNumB)));
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Distance Matrix (A vs B)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MatrixXd calcDistanceMatrix(const MatrixX3d &coordMatrixA, const MatrixX3d &coordMatrixB)
+{
+    MatrixXd disMatrix(coordMatrixA.rows(), coordMatrixB.rows());
+
+    __forEachDistanceTile(coordMatrixA, coordMatrixB, false,
+        [&](int startIdxA, int startIdxB, const MatrixXd &squaredDisMatrix)
+        {
+            disMatrix.block(startIdxA, startIdxB, squaredDisMatrix.rows(), squaredDisMatrix.cols()) =
+                squaredDisMatrix.cwiseSqrt();
+        });
+
+    return disMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Distance Matrix (Symmetric)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MatrixXd calcDistanceMatrix(const MatrixX3d &coordMatrix)
+{
+    MatrixXd disMatrix(coordMatrix.rows(), coordMatrix.rows());
+
+    __forEachDistanceTile(coordMatrix, coordMatrix, true,
+        [&](int startIdxA, int startIdxB, const MatrixXd &squaredDisMatrix)
+        {
+            disMatrix.block(startIdxA, startIdxB, squaredDisMatrix.rows(), squaredDisMatrix.cols()) =
+                squaredDisMatrix.cwiseSqrt();
+
+            disMatrix.block(startIdxB, startIdxA, squaredDisMatrix.cols(), squaredDisMatrix.rows()) =
+                squaredDisMatrix.cwiseSqrt().transpose();
+        });
+
+    return disMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Contact Map (A vs B, Dense)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Matrix<bool, Dynamic, Dynamic> calcContactMap(const MatrixX3d &coordMatrixA, const MatrixX3d &coordMatrixB,
+    double cutoff)
+{
+    Matrix<bool, Dynamic, Dynamic> contactMap(coordMatrixA.rows(), coordMatrixB.rows());
+
+    __forEachDistanceTile(coordMatrixA, coordMatrixB, false,
+        [&](int startIdxA, int startIdxB, const MatrixXd &squaredDisMatrix)
+        {
+            contactMap.block(startIdxA, startIdxB, squaredDisMatrix.rows(), squaredDisMatrix.cols()) =
+                (squaredDisMatrix.array() <= cutoff * cutoff).matrix();
+        });
+
+    return contactMap;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Contact Map (Symmetric, Dense)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Matrix<bool, Dynamic, Dynamic> calcContactMap(const MatrixX3d &coordMatrix, double cutoff)
+{
+    Matrix<bool, Dynamic, Dynamic> contactMap(coordMatrix.rows(), coordMatrix.rows());
+
+    __forEachDistanceTile(coordMatrix, coordMatrix, true,
+        [&](int startIdxA, int startIdxB, const MatrixXd &squaredDisMatrix)
+        {
+            contactMap.block(startIdxA, startIdxB, squaredDisMatrix.rows(), squaredDisMatrix.cols()) =
+                (squaredDisMatrix.array() <= cutoff * cutoff).matrix();
+
+            contactMap.block(startIdxB, startIdxA, squaredDisMatrix.cols(), squaredDisMatrix.rows()) =
+                (squaredDisMatrix.array() <= cutoff * cutoff).matrix().transpose();
+        });
+
+    return contactMap;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Sparse Contact Map (A vs B)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<pair<int, int>> calcSparseContactMap(const MatrixX3d &coordMatrixA, const MatrixX3d &coordMatrixB,
+    double cutoff)
+{
+    CellList cellListObj(coordMatrixB, cutoff);
+
+    vector<vector<int>> idxListList(coordMatrixA.rows());
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int idxA = 0; idxA < coordMatrixA.rows(); idxA++)
+    {
+        idxListList[idxA] = cellListObj.queryRadius(coordMatrixA.row(idxA), cutoff);
+    }
+
+    vector<pair<int, int>> contactList;
+
+    for (int idxA = 0; idxA < (int) idxListList.size(); idxA++)
+    {
+        for (int idxB: idxListList[idxA])
+        {
+            contactList.emplace_back(idxA, idxB);
+        }
+    }
+
+    return contactList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Sparse Contact Map (Symmetric, i < j)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<pair<int, int>> calcSparseContactMap(const MatrixX3d &coordMatrix, double cutoff)
+{
+    return CellList(coordMatrix, cutoff).getPairs(cutoff);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Bit Contact Map (A vs B, One Bitset Per Row Of A)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<dynamic_bitset<>> calcBitContactMap(const MatrixX3d &coordMatrixA, const MatrixX3d &coordMatrixB,
+    double cutoff)
+{
+    vector<dynamic_bitset<>> contactMap(coordMatrixA.rows(), dynamic_bitset<>(coordMatrixB.rows()));
+
+    // Parallel Over Row Tiles Only, So That No Two Threads Write The Same Bitset
+    #pragma omp parallel for schedule(dynamic)
+    for (int startIdxA = 0; startIdxA < coordMatrixA.rows(); startIdxA += __DISTANCE_TILE_SIZE)
+    {
+        int rowNumA = min(__DISTANCE_TILE_SIZE, int(coordMatrixA.rows()) - startIdxA);
+
+        for (int startIdxB = 0; startIdxB < coordMatrixB.rows(); startIdxB += __DISTANCE_TILE_SIZE)
+        {
+            int rowNumB = min(__DISTANCE_TILE_SIZE, int(coordMatrixB.rows()) - startIdxB);
+
+            MatrixXd squaredDisMatrix = __calcSquaredDistanceTile(
+                coordMatrixA.middleRows(startIdxA, rowNumA), coordMatrixB.middleRows(startIdxB, rowNumB));
+
+            for (int idxB = 0; idxB < rowNumB; idxB++)
+            {
+                for (int idxA = 0; idxA < rowNumA; idxA++)
+                {
+                    if (squaredDisMatrix(idxA, idxB) <= cutoff * cutoff)
+                    {
+                        contactMap[startIdxA + idxA].set(startIdxB + idxB);
+                    }
+                }
+            }
+        }
+    }
+
+    return contactMap;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Bit Contact Map (Symmetric)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<dynamic_bitset<>> calcBitContactMap(const MatrixX3d &coordMatrix, double cutoff)
+{
+    return calcBitContactMap(coordMatrix, coordMatrix, cutoff);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Gather Residue Atoms Coord
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+pair<MatrixX3d, vector<int>> __gatherResidueAtomsCoord(const vector<Residue *> &resPtrList)
+{
+    vector<int> resStartIdxList {0};
+
+    for (auto resPtr: resPtrList)
+    {
+        resStartIdxList.push_back(resStartIdxList.back() + resPtr->sub().size());
+    }
+
+    MatrixX3d coordMatrix(resStartIdxList.back(), 3);
+
+    for (int resIdx = 0; resIdx < (int) resPtrList.size(); resIdx++)
+    {
+        for (int atomIdx = 0; atomIdx < (int) resPtrList[resIdx]->sub().size(); atomIdx++)
+        {
+            coordMatrix.row(resStartIdxList[resIdx] + atomIdx) = resPtrList[resIdx]->sub()[atomIdx]->coord();
+        }
+    }
+
+    return {coordMatrix, resStartIdxList};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Residue Min Distance Matrix (A vs B)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MatrixXd calcResidueMinDistanceMatrix(const vector<Residue *> &resPtrListA, const vector<Residue *> &resPtrListB)
+{
+    auto [coordMatrixA, resStartIdxListA] = __gatherResidueAtomsCoord(resPtrListA);
+    auto [coordMatrixB, resStartIdxListB] = __gatherResidueAtomsCoord(resPtrListB);
+
+    MatrixXd disMatrix(resPtrListA.size(), resPtrListB.size());
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int resIdxA = 0; resIdxA < (int) resPtrListA.size(); resIdxA++)
+    {
+        int atomNumA = resStartIdxListA[resIdxA + 1] - resStartIdxListA[resIdxA];
+
+        if (atomNumA == 0)
+        {
+            disMatrix.row(resIdxA).setConstant(numeric_limits<double>::quiet_NaN());
+            continue;
+        }
+
+        // All Atoms Of Residue A Against Every Atom Of B At Once, Then Reduce Per Residue Of B
+        VectorXd squaredDisList = __calcSquaredDistanceTile(coordMatrixB,
+            coordMatrixA.middleRows(resStartIdxListA[resIdxA], atomNumA)).rowwise().minCoeff();
+
+        for (int resIdxB = 0; resIdxB < (int) resPtrListB.size(); resIdxB++)
+        {
+            int atomNumB = resStartIdxListB[resIdxB + 1] - resStartIdxListB[resIdxB];
+
+            disMatrix(resIdxA, resIdxB) = atomNumB ?
+                sqrt(squaredDisList.segment(resStartIdxListB[resIdxB], atomNumB).minCoeff()) :
+                numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+    return disMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Residue Min Distance Matrix (Symmetric)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MatrixXd calcResidueMinDistanceMatrix(const vector<Residue *> &resPtrList)
+{
+    return calcResidueMinDistanceMatrix(resPtrList, resPtrList);
+}
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,496 @@
+/*
+    DSSP.hpp
+    ========
+        DSSP secondary structure assignment implementation.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <Eigen/Dense>
+#include "Residue.h"
+#include "Atom.h"
+#include "CellList.hpp"
+#include "Math.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::deque;
+using std::pair;
+using std::min;
+using std::max;
+using std::sort;
+using std::unique;
+using std::round;
+using Eigen::RowVector3d;
+using Eigen::MatrixX3d;
+using Eigen::MatrixX2i;
+using Eigen::MatrixX2d;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSSP Constants (Kabsch & Sander, 1983)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const double __DSSP_COUPLING_CONSTANT   = -27.888;
+const double __DSSP_MIN_HBOND_ENERGY    = -9.9;
+const double __DSSP_MAX_HBOND_ENERGY    = -0.5;
+const double __DSSP_MIN_CA_DIS          = 9.;
+const double __DSSP_MAX_PEPTIDE_BOND    = 2.5;
+const double __DSSP_MIN_BEND_ANGLE      = 70. * M_PI / 180.;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSSP Backbone
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct __DSSPBackbone
+{
+    MatrixX3d NCoordMatrix;
+    MatrixX3d CACoordMatrix;
+    MatrixX3d CCoordMatrix;
+    MatrixX3d OCoordMatrix;
+    MatrixX3d HCoordMatrix;
+    vector<bool> validBoolList;
+    vector<bool> proBoolList;
+    vector<int> breakCountList;
+
+
+    // No Chain Break Between Residue startIdx And endIdx
+    bool noBreak(int startIdx, int endIdx) const
+    {
+        return startIdx >= 0 && endIdx < (int) breakCountList.size() && startIdx <= endIdx &&
+            breakCountList[endIdx] == breakCountList[startIdx];
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSSP Ladder
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct __DSSPLadder
+{
+    bool parallelBool;
+    deque<int> idxListI;
+    deque<int> idxListJ;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc DSSP Backbone
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+__DSSPBackbone __calcDSSPBackbone(const vector<Residue *> &resPtrList)
+{
+    int resNum = resPtrList.size();
+
+    __DSSPBackbone bbObj {
+        MatrixX3d::Constant(resNum, 3, NAN), MatrixX3d::Constant(resNum, 3, NAN),
+        MatrixX3d::Constant(resNum, 3, NAN), MatrixX3d::Constant(resNum, 3, NAN),
+        MatrixX3d::Constant(resNum, 3, NAN), vector<bool>(resNum), vector<bool>(resNum), vector<int>(resNum)
+    };
+
+    for (int resIdx = 0; resIdx < resNum; resIdx++)
+    {
+        for (auto atomPtr: *resPtrList[resIdx])
+        {
+            if (atomPtr->name() == "N")
+            {
+                bbObj.NCoordMatrix.row(resIdx) = atomPtr->coord();
+            }
+            else if (atomPtr->name() == "CA")
+            {
+                bbObj.CACoordMatrix.row(resIdx) = atomPtr->coord();
+            }
+            else if (atomPtr->name() == "C")
+            {
+                bbObj.CCoordMatrix.row(resIdx) = atomPtr->coord();
+            }
+            else if (atomPtr->name() == "O")
+            {
+                bbObj.OCoordMatrix.row(resIdx) = atomPtr->coord();
+            }
+        }
+
+        bbObj.validBoolList[resIdx] = !(
+            bbObj.NCoordMatrix.row(resIdx).hasNaN()  || bbObj.CACoordMatrix.row(resIdx).hasNaN() ||
+            bbObj.CCoordMatrix.row(resIdx).hasNaN() || bbObj.OCoordMatrix.row(resIdx).hasNaN());
+
+        bbObj.proBoolList[resIdx] = resPtrList[resIdx]->name() == "PRO";
+    }
+
+    for (int resIdx = 0; resIdx < resNum; resIdx++)
+    {
+        bool breakBool = resIdx == 0 || !bbObj.validBoolList[resIdx - 1] || !bbObj.validBoolList[resIdx] ||
+            resPtrList[resIdx - 1]->owner() != resPtrList[resIdx]->owner() ||
+            (bbObj.CCoordMatrix.row(resIdx - 1) - bbObj.NCoordMatrix.row(resIdx)).norm() > __DSSP_MAX_PEPTIDE_BOND;
+
+        bbObj.breakCountList[resIdx] = (resIdx ? bbObj.breakCountList[resIdx - 1] : 0) + (resIdx && breakBool);
+
+        // Virtual H: N + Unit(C - O) Of The Previous Residue, Or N Itself After A Chain Break
+        if (breakBool)
+        {
+            bbObj.HCoordMatrix.row(resIdx) = bbObj.NCoordMatrix.row(resIdx);
+        }
+        else
+        {
+            bbObj.HCoordMatrix.row(resIdx) = bbObj.NCoordMatrix.row(resIdx) +
+                (bbObj.CCoordMatrix.row(resIdx - 1) - bbObj.OCoordMatrix.row(resIdx - 1)).normalized();
+        }
+    }
+
+    return bbObj;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc DSSP HBond Energy (kcal/mol)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double __calcDSSPHBondEnergy(const __DSSPBackbone &bbObj, int donorIdx, int acceptorIdx)
+{
+    if (bbObj.proBoolList[donorIdx])
+    {
+        return 0.;
+    }
+
+    double disHO = (bbObj.HCoordMatrix.row(donorIdx) - bbObj.OCoordMatrix.row(acceptorIdx)).norm();
+    double disHC = (bbObj.HCoordMatrix.row(donorIdx) - bbObj.CCoordMatrix.row(acceptorIdx)).norm();
+    double disNC = (bbObj.NCoordMatrix.row(donorIdx) - bbObj.CCoordMatrix.row(acceptorIdx)).norm();
+    double disNO = (bbObj.NCoordMatrix.row(donorIdx) - bbObj.OCoordMatrix.row(acceptorIdx)).norm();
+
+    if (disHO < 0.5 || disHC < 0.5 || disNC < 0.5 || disNO < 0.5)
+    {
+        return __DSSP_MIN_HBOND_ENERGY;
+    }
+
+    double hbondEnergy = __DSSP_COUPLING_CONSTANT * (1. / disHO - 1. / disHC + 1. / disNC - 1. / disNO);
+
+    return max(round(hbondEnergy * 1000.) / 1000., __DSSP_MIN_HBOND_ENERGY);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc DSSP Ladder List
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Func>
+vector<__DSSPLadder> __calcDSSPLadderList(const __DSSPBackbone &bbObj, const MatrixX2i &acceptorIdxMatrix,
+    Func &&testBond)
+{
+    int resNum = bbObj.breakCountList.size();
+
+    // Every Bridge Pattern Contains An HBond Between i - 1 ~ i + 1 And j - 1 ~ j + 1, So Only Those Pairs Are Tested
+    vector<pair<int, int>> bridgePairList;
+
+    for (int donorIdx = 0; donorIdx < resNum; donorIdx++)
+    {
+        for (int acceptorIdx: {acceptorIdxMatrix(donorIdx, 0), acceptorIdxMatrix(donorIdx, 1)})
+        {
+            if (acceptorIdx < 0 || !testBond(donorIdx, acceptorIdx))
+            {
+                continue;
+            }
+
+            for (int shiftI = -1; shiftI <= 1; shiftI++)
+            {
+                for (int shiftJ = -1; shiftJ <= 1; shiftJ++)
+                {
+                    int resIdxI = min(donorIdx + shiftI, acceptorIdx + shiftJ);
+                    int resIdxJ = max(donorIdx + shiftI, acceptorIdx + shiftJ);
+
+                    if (resIdxI >= 1 && resIdxJ >= resIdxI + 3 && resIdxJ + 1 < resNum)
+                    {
+                        bridgePairList.emplace_back(resIdxI, resIdxJ);
+                    }
+                }
+            }
+        }
+    }
+
+    sort(bridgePairList.begin(), bridgePairList.end());
+    bridgePairList.erase(unique(bridgePairList.begin(), bridgePairList.end()), bridgePairList.end());
+
+    vector<__DSSPLadder> ladderList;
+
+    // Bridges In (i, j) Order, Extended Into Ladders On The Fly
+    for (auto [resIdxI, resIdxJ]: bridgePairList)
+    {
+        if (!bbObj.noBreak(resIdxI - 1, resIdxI + 1) || !bbObj.noBreak(resIdxJ - 1, resIdxJ + 1))
+        {
+            continue;
+        }
+
+        int bridgeType = 0;
+
+        if ((testBond(resIdxI + 1, resIdxJ) && testBond(resIdxJ, resIdxI - 1)) ||
+            (testBond(resIdxJ + 1, resIdxI) && testBond(resIdxI, resIdxJ - 1)))
+        {
+            bridgeType = 1;
+        }
+        else if ((testBond(resIdxI + 1, resIdxJ - 1) && testBond(resIdxJ + 1, resIdxI - 1)) ||
+            (testBond(resIdxJ, resIdxI) && testBond(resIdxI, resIdxJ)))
+        {
+            bridgeType = 2;
+        }
+
+        if (!bridgeType)
+        {
+            continue;
+        }
+
+        bool foundBool = false;
+
+        for (auto &ladderObj: ladderList)
+        {
+            if (ladderObj.parallelBool != (bridgeType == 1) || resIdxI != ladderObj.idxListI.back() + 1)
+            {
+                continue;
+            }
+
+            if (ladderObj.parallelBool && ladderObj.idxListJ.back() + 1 == resIdxJ)
+            {
+                ladderObj.idxListI.push_back(resIdxI);
+                ladderObj.idxListJ.push_back(resIdxJ);
+                foundBool = true;
+                break;
+            }
+
+            if (!ladderObj.parallelBool && ladderObj.idxListJ.front() - 1 == resIdxJ)
+            {
+                ladderObj.idxListI.push_back(resIdxI);
+                ladderObj.idxListJ.push_front(resIdxJ);
+                foundBool = true;
+                break;
+            }
+        }
+
+        if (!foundBool)
+        {
+            ladderList.push_back({bridgeType == 1, {resIdxI}, {resIdxJ}});
+        }
+    }
+
+    // Bulge Linking
+    for (int ladderIdxA = 0; ladderIdxA < (int) ladderList.size(); ladderIdxA++)
+    {
+        for (int ladderIdxB = ladderIdxA + 1; ladderIdxB < (int) ladderList.size(); ladderIdxB++)
+        {
+            auto &ladderA = ladderList[ladderIdxA], &ladderB = ladderList[ladderIdxB];
+
+            int startIA = ladderA.idxListI.front(), endIA = ladderA.idxListI.back();
+            int startJA = ladderA.idxListJ.front(), endJA = ladderA.idxListJ.back();
+            int startIB = ladderB.idxListI.front(), endIB = ladderB.idxListI.back();
+            int startJB = ladderB.idxListJ.front(), endJB = ladderB.idxListJ.back();
+
+            if (ladderA.parallelBool != ladderB.parallelBool ||
+                !bbObj.noBreak(min(startIA, startIB), max(endIA, endIB)) ||
+                !bbObj.noBreak(min(startJA, startJB), max(endJA, endJB)) ||
+                startIB - endIA >= 6 || (endIA >= startIB && startIA <= endIB))
+            {
+                continue;
+            }
+
+            // DSSP Takes These Gaps As Unsigned: A Partner Strand Running Backwards Never Links
+            int gapI = startIB - endIA;
+            int gapJ = ladderA.parallelBool ? startJB - endJA : startJA - endJB;
+
+            bool bulgeBool = gapJ >= 0 && ((gapJ < 6 && gapI < 3) || gapJ < 3);
+
+            if (bulgeBool)
+            {
+                ladderA.idxListI.insert(ladderA.idxListI.end(), ladderB.idxListI.begin(), ladderB.idxListI.end());
+
+                if (ladderA.parallelBool)
+                {
+                    ladderA.idxListJ.insert(ladderA.idxListJ.end(), ladderB.idxListJ.begin(), ladderB.idxListJ.end());
+                }
+                else
+                {
+                    ladderA.idxListJ.insert(ladderA.idxListJ.begin(), ladderB.idxListJ.begin(), ladderB.idxListJ.end());
+                }
+
+                ladderList.erase(ladderList.begin() + ladderIdxB);
+                ladderIdxB--;
+            }
+        }
+    }
+
+    return ladderList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Secondary Structure (DSSP)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string calcSecondaryStructure(const vector<Residue *> &resPtrList)
+{
+    int resNum = resPtrList.size();
+
+    auto bbObj = __calcDSSPBackbone(resPtrList);
+
+    // HBond Candidates: Residue Pairs Whose CA Atoms Are Within 9 Angstroms
+    vector<int> validIdxList;
+
+    for (int resIdx = 0; resIdx < resNum; resIdx++)
+    {
+        if (bbObj.validBoolList[resIdx])
+        {
+            validIdxList.push_back(resIdx);
+        }
+    }
+
+    MatrixX3d validCACoordMatrix(validIdxList.size(), 3);
+
+    for (int idx = 0; idx < (int) validIdxList.size(); idx++)
+    {
+        validCACoordMatrix.row(idx) = bbObj.CACoordMatrix.row(validIdxList[idx]);
+    }
+
+    // The Two Lowest Energy Acceptors Of Each Donor
+    MatrixX2i acceptorIdxMatrix    = MatrixX2i::Constant(resNum, 2, -1);
+    MatrixX2d acceptorEnergyMatrix = MatrixX2d::Zero(resNum, 2);
+
+    auto addHBond = [&](int donorIdx, int acceptorIdx)
+    {
+        double hbondEnergy = __calcDSSPHBondEnergy(bbObj, donorIdx, acceptorIdx);
+
+        if (hbondEnergy < acceptorEnergyMatrix(donorIdx, 0))
+        {
+            acceptorIdxMatrix(donorIdx, 1)    = acceptorIdxMatrix(donorIdx, 0);
+            acceptorEnergyMatrix(donorIdx, 1) = acceptorEnergyMatrix(donorIdx, 0);
+            acceptorIdxMatrix(donorIdx, 0)    = acceptorIdx;
+            acceptorEnergyMatrix(donorIdx, 0) = hbondEnergy;
+        }
+        else if (hbondEnergy < acceptorEnergyMatrix(donorIdx, 1))
+        {
+            acceptorIdxMatrix(donorIdx, 1)    = acceptorIdx;
+            acceptorEnergyMatrix(donorIdx, 1) = hbondEnergy;
+        }
+    };
+
+    CellList(validCACoordMatrix, __DSSP_MIN_CA_DIS).forEachPair(__DSSP_MIN_CA_DIS, [&](int idxA, int idxB, double)
+    {
+        int resIdxI = validIdxList[idxA], resIdxJ = validIdxList[idxB];
+
+        addHBond(resIdxI, resIdxJ);
+
+        if (resIdxJ != resIdxI + 1)
+        {
+            addHBond(resIdxJ, resIdxI);
+        }
+    });
+
+    // N-H Of donorIdx => O Of acceptorIdx
+    auto testBond = [&](int donorIdx, int acceptorIdx)
+    {
+        return (acceptorIdxMatrix(donorIdx, 0) == acceptorIdx &&
+                acceptorEnergyMatrix(donorIdx, 0) < __DSSP_MAX_HBOND_ENERGY) ||
+               (acceptorIdxMatrix(donorIdx, 1) == acceptorIdx &&
+                acceptorEnergyMatrix(donorIdx, 1) < __DSSP_MAX_HBOND_ENERGY);
+    };
+
+    string ssStr(resNum, '-');
+
+    // Strands (E) And Isolated Bridges (B)
+    for (auto &ladderObj: __calcDSSPLadderList(bbObj, acceptorIdxMatrix, testBond))
+    {
+        char ssChar = ladderObj.idxListI.size() > 1 ? 'E' : 'B';
+
+        for (auto idxListPtr: {&ladderObj.idxListI, &ladderObj.idxListJ})
+        {
+            for (int resIdx = idxListPtr->front(); resIdx <= idxListPtr->back(); resIdx++)
+            {
+                if (ssStr[resIdx] != 'E')
+                {
+                    ssStr[resIdx] = ssChar;
+                }
+            }
+        }
+    }
+
+    // N-Turns: O Of i => N-H Of i + n, n = 3, 4, 5
+    vector<vector<bool>> turnBoolList(3, vector<bool>(resNum));
+
+    for (int turnLen = 3; turnLen <= 5; turnLen++)
+    {
+        for (int resIdx = 0; resIdx + turnLen < resNum; resIdx++)
+        {
+            turnBoolList[turnLen - 3][resIdx] = bbObj.noBreak(resIdx, resIdx + turnLen) &&
+                testBond(resIdx + turnLen, resIdx);
+        }
+    }
+
+    // Helices: Two Consecutive N-Turns; Alpha (H) First, Then 3-10 (G) And Pi (I) Only Into Free Residues
+    for (int turnLen: {4, 3, 5})
+    {
+        char ssChar = turnLen == 4 ? 'H' : (turnLen == 3 ? 'G' : 'I');
+
+        for (int resIdx = 1; resIdx + turnLen <= resNum; resIdx++)
+        {
+            if (!turnBoolList[turnLen - 3][resIdx - 1] || !turnBoolList[turnLen - 3][resIdx])
+            {
+                continue;
+            }
+
+            bool freeBool = true;
+
+            for (int helixIdx = resIdx; helixIdx < resIdx + turnLen && turnLen != 4; helixIdx++)
+            {
+                freeBool = freeBool && (ssStr[helixIdx] == '-' || ssStr[helixIdx] == ssChar);
+            }
+
+            for (int helixIdx = resIdx; helixIdx < resIdx + turnLen && freeBool; helixIdx++)
+            {
+                ssStr[helixIdx] = ssChar;
+            }
+        }
+    }
+
+    // Turns (T) And Bends (S)
+    for (int resIdx = 1; resIdx + 1 < resNum; resIdx++)
+    {
+        if (ssStr[resIdx] != '-')
+        {
+            continue;
+        }
+
+        for (int turnLen = 3; turnLen <= 5 && ssStr[resIdx] == '-'; turnLen++)
+        {
+            for (int shiftLen = 1; shiftLen < turnLen && shiftLen <= resIdx; shiftLen++)
+            {
+                if (turnBoolList[turnLen - 3][resIdx - shiftLen])
+                {
+                    ssStr[resIdx] = 'T';
+                    break;
+                }
+            }
+        }
+
+        if (ssStr[resIdx] == '-' && bbObj.noBreak(resIdx - 2, resIdx + 2) &&
+            calcVectorAngle(bbObj.CACoordMatrix.row(resIdx) - bbObj.CACoordMatrix.row(resIdx - 2),
+                bbObj.CACoordMatrix.row(resIdx + 2) - bbObj.CACoordMatrix.row(resIdx)) > __DSSP_MIN_BEND_ANGLE)
+        {
+            ssStr[resIdx] = 'S';
+        }
+    }
+
+    return ssStr;
+}
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,258 @@
+/*
+    ENM.hpp
+    =======
+        Elastic network model (GNM / ANM) functions implementation.
+*/
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <boost/format.hpp>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include "CellList.hpp"
+#include "Math.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::vector;
+using std::pair;
+using std::min;
+using std::runtime_error;
+using boost::format;
+using Eigen::RowVector3d;
+using Eigen::Matrix3d;
+using Eigen::MatrixX3d;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+using Eigen::SparseMatrix;
+using Eigen::Triplet;
+using Eigen::SelfAdjointEigenSolver;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Normal Mode Eigensolver Parameters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Extra Block Vectors Beyond The Requested Modes (Faster Convergence Of The Last Requested Mode)
+const int __ENM_EXTRA_BLOCK_NUM = 10;
+
+const int __ENM_MAX_ITER = 1000;
+
+// Residual Norm Relative To The Mean Diagonal
+const double __ENM_RESIDUAL_TOL = 1e-6;
+
+// Keeps The Jacobi Preconditioner Finite For Isolated Nodes
+const double __ENM_PRECOND_SHIFT_RATIO = 1e-6;
+
+const unsigned __ENM_RANDOM_SEED = 0;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc GNM Kirchhoff Matrix (Sparse, N * N)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SparseMatrix<double> calcGNMKirchhoffMatrix(const MatrixX3d &coordMatrix, double cutoff = 7.3, double gamma = 1.)
+{
+    int atomNum = coordMatrix.rows();
+
+    auto pairList = CellList(coordMatrix, cutoff).getPairs(cutoff);
+
+    vector<Triplet<double>> tripletList;
+    VectorXd degreeList = VectorXd::Zero(atomNum);
+
+    tripletList.reserve(pairList.size() * 2 + atomNum);
+
+    for (auto [atomIdxI, atomIdxJ]: pairList)
+    {
+        tripletList.emplace_back(atomIdxI, atomIdxJ, -gamma);
+        tripletList.emplace_back(atomIdxJ, atomIdxI, -gamma);
+
+        degreeList[atomIdxI] += gamma;
+        degreeList[atomIdxJ] += gamma;
+    }
+
+    for (int atomIdx = 0; atomIdx < atomNum; atomIdx++)
+    {
+        tripletList.emplace_back(atomIdx, atomIdx, degreeList[atomIdx]);
+    }
+
+    SparseMatrix<double> kirchhoffMatrix(atomNum, atomNum);
+
+    kirchhoffMatrix.setFromTriplets(tripletList.begin(), tripletList.end());
+
+    return kirchhoffMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc ANM Hessian Matrix (Sparse, 3N * 3N, Atom-Major)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SparseMatrix<double> calcANMHessianMatrix(const MatrixX3d &coordMatrix, double cutoff = 15., double gamma = 1.)
+{
+    int atomNum = coordMatrix.rows();
+
+    auto pairList = CellList(coordMatrix, cutoff).getPairs(cutoff);
+
+    vector<Triplet<double>> tripletList;
+    vector<Matrix3d> diagBlockList(atomNum, Matrix3d::Zero());
+
+    tripletList.reserve(pairList.size() * 18 + atomNum * 9);
+
+    for (auto [atomIdxI, atomIdxJ]: pairList)
+    {
+        RowVector3d diffCoord = coordMatrix.row(atomIdxJ) - coordMatrix.row(atomIdxI);
+
+        // Super-Element: -gamma / d^2 * (r_ij^T * r_ij)
+        Matrix3d offDiagBlock = -gamma / diffCoord.squaredNorm() * diffCoord.transpose() * diffCoord;
+
+        for (int rowIdx = 0; rowIdx < 3; rowIdx++)
+        {
+            for (int colIdx = 0; colIdx < 3; colIdx++)
+            {
+                tripletList.emplace_back(atomIdxI * 3 + rowIdx, atomIdxJ * 3 + colIdx, offDiagBlock(rowIdx, colIdx));
+                tripletList.emplace_back(atomIdxJ * 3 + rowIdx, atomIdxI * 3 + colIdx, offDiagBlock(rowIdx, colIdx));
+            }
+        }
+
+        diagBlockList[atomIdxI] -= offDiagBlock;
+        diagBlockList[atomIdxJ] -= offDiagBlock;
+    }
+
+    for (int atomIdx = 0; atomIdx < atomNum; atomIdx++)
+    {
+        for (int rowIdx = 0; rowIdx < 3; rowIdx++)
+        {
+            for (int colIdx = 0; colIdx < 3; colIdx++)
+            {
+                tripletList.emplace_back(atomIdx * 3 + rowIdx, atomIdx * 3 + colIdx,
+                    diagBlockList[atomIdx](rowIdx, colIdx));
+            }
+        }
+    }
+
+    SparseMatrix<double> hessianMatrix(atomNum * 3, atomNum * 3);
+
+    hessianMatrix.setFromTriplets(tripletList.begin(), tripletList.end());
+
+    return hessianMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Lowest Normal Modes (LOBPCG With Jacobi Preconditioner, Sparse Matrix-Vector Products Only)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+pair<VectorXd, MatrixXd> calcLowestNormalModes(const SparseMatrix<double> &hessianMatrix, int modeNum = 20,
+    int zeroModeNum = 0)
+{
+    int dimNum = hessianMatrix.rows();
+    int wantNum = min(modeNum + zeroModeNum, dimNum);
+    int blockNum = min(wantNum + __ENM_EXTRA_BLOCK_NUM, dimNum);
+
+    if (wantNum <= zeroModeNum)
+    {
+        return {VectorXd(), MatrixXd(dimNum, 0)};
+    }
+
+    // Small Matrix (Or Nearly All Modes Wanted): The Subspace Would Not Be Smaller Than The Matrix
+    if (blockNum * 3 >= dimNum)
+    {
+        SelfAdjointEigenSolver<MatrixXd> eigenSolver{MatrixXd(hessianMatrix)};
+
+        return {eigenSolver.eigenvalues().segment(zeroModeNum, wantNum - zeroModeNum),
+            eigenSolver.eigenvectors().middleCols(zeroModeNum, wantNum - zeroModeNum)};
+    }
+
+    double diagMean = hessianMatrix.diagonal().mean();
+    VectorXd precondList = (hessianMatrix.diagonal().array() + __ENM_PRECOND_SHIFT_RATIO * diagMean).inverse();
+
+    MatrixXd basisMatrix = __orthonormalizeColumns(__calcRandomNormalMatrix(dimNum, blockNum, __ENM_RANDOM_SEED));
+    MatrixXd productMatrix = hessianMatrix * basisMatrix;
+    MatrixXd searchMatrix(dimNum, 0);
+
+    SelfAdjointEigenSolver<MatrixXd> eigenSolver(basisMatrix.transpose() * productMatrix);
+
+    basisMatrix    = basisMatrix * eigenSolver.eigenvectors();
+    productMatrix  = productMatrix * eigenSolver.eigenvectors();
+    VectorXd eigenvalueList = eigenSolver.eigenvalues();
+
+    bool convergedBool = false;
+    double maxResidual = 0.;
+
+    for (int iterIdx = 0; iterIdx < __ENM_MAX_ITER; iterIdx++)
+    {
+        MatrixXd residualMatrix = productMatrix - basisMatrix * eigenvalueList.asDiagonal();
+
+        maxResidual = residualMatrix.leftCols(wantNum).colwise().norm().maxCoeff();
+
+        if (maxResidual <= __ENM_RESIDUAL_TOL * diagMean)
+        {
+            convergedBool = true;
+            break;
+        }
+
+        // Rayleigh-Ritz On [Ritz Vectors, Preconditioned Residuals, Previous Search Directions]
+        MatrixXd trialMatrix(dimNum, blockNum * 2 + searchMatrix.cols());
+
+        trialMatrix << basisMatrix, precondList.asDiagonal() * residualMatrix, searchMatrix;
+
+        MatrixXd subspaceMatrix = __orthonormalizeColumns(trialMatrix);
+        MatrixXd subspaceProductMatrix = hessianMatrix * subspaceMatrix;
+
+        eigenSolver.compute(subspaceMatrix.transpose() * subspaceProductMatrix);
+
+        MatrixXd ritzMatrix = eigenSolver.eigenvectors().leftCols(blockNum);
+
+        basisMatrix    = subspaceMatrix * ritzMatrix;
+        productMatrix  = subspaceProductMatrix * ritzMatrix;
+        eigenvalueList = eigenSolver.eigenvalues().head(blockNum);
+
+        // The First blockNum Columns Of The Subspace Span The Old Ritz Vectors, The Rest Is The New Search Direction
+        searchMatrix = subspaceMatrix.rightCols(subspaceMatrix.cols() - blockNum) *
+            ritzMatrix.bottomRows(subspaceMatrix.cols() - blockNum);
+    }
+
+    if (!convergedBool)
+    {
+        throw runtime_error((format("LOBPCG did not converge in %d iterations (max residual: %g, tolerance: %g)") %
+            __ENM_MAX_ITER % maxResidual % (__ENM_RESIDUAL_TOL * diagMean)).str());
+    }
+
+    return {eigenvalueList.segment(zeroModeNum, wantNum - zeroModeNum),
+        basisMatrix.middleCols(zeroModeNum, wantNum - zeroModeNum)};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc GNM Fluctuations (Per Residue, sum_k u_ik^2 / lambda_k, In Units Of kT / gamma)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorXd calcGNMFluctuations(const VectorXd &eigenvalueList, const MatrixXd &modeMatrix)
+{
+    return modeMatrix.cwiseAbs2() * eigenvalueList.cwiseInverse();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc ANM Fluctuations (Per Residue, x + y + z Components, In Units Of kT / gamma)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorXd calcANMFluctuations(const VectorXd &eigenvalueList, const MatrixXd &modeMatrix)
+{
+    VectorXd componentFluctuationList = modeMatrix.cwiseAbs2() * eigenvalueList.cwiseInverse();
+
+    return componentFluctuationList.reshaped(3, componentFluctuationList.size() / 3).colwise().sum().transpose();
+}
+
+
+}  // End namespace PDBTools
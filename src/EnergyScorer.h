@@ -0,0 +1,130 @@
+/*
+    EnergyScorer.h
+    ==============
+        Class EnergyScorer header.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <iostream>
+#include <Eigen/Dense>
+#include "Predecl.h"
+#include "PairExclusion.h"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::ostream;
+using Eigen::MatrixX3d;
+using Eigen::VectorXd;
+using Eigen::ArrayXd;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Class EnergyScorer
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class EnergyScorer
+{
+    // Friend
+    friend ostream &operator<<(ostream &os, const EnergyScorer &energyScorerObj);
+
+
+public:
+
+    // Constructor
+    explicit EnergyScorer(const vector<Atom *> &atomPtrList, double cutoff = 8., double skin = 2.,
+        const VectorXd &chargeList = VectorXd(), double scale14 = 0.5);
+
+
+    // Getter: __cutoff
+    double cutoff() const;
+
+
+    // Getter: __chargeList
+    const VectorXd &chargeList() const;
+
+
+    // Getter: __scale14
+    double scale14() const;
+
+
+    // Getter: __ljEnergy
+    double ljEnergy() const;
+
+
+    // Getter: __coulombEnergy
+    double coulombEnergy() const;
+
+
+    // Pair Num (Pairs In The Neighbor List)
+    int pairNum() const;
+
+
+    // Calc Energy (Rescores Only The Atoms Whose Coord Changed)
+    double calcEnergy();
+
+
+    // Calc Energy (Moved Atoms)
+    double calcEnergy(const vector<Atom *> &movedAtomPtrList);
+
+
+    // Calc Full Energy
+    double calcFullEnergy();
+
+
+private:
+
+    // Data
+    vector<Atom *> __atomPtrList;
+    unordered_map<Atom *, int> __atomIdxMap;
+    __PairExclusion __pairExclusion;
+    VectorXd __rminList;
+    VectorXd __sqrtEpsList;
+    VectorXd __chargeList;
+    double __cutoff;
+    double __skin;
+    double __scale14;
+    MatrixX3d __coordMatrix;
+    MatrixX3d __listCoordMatrix;
+    vector<int> __pairAtomIdxListI;
+    vector<int> __pairAtomIdxListJ;
+    ArrayXd __pairSquaredRminList;
+    ArrayXd __pairEpsList;
+    ArrayXd __pairChargeProductList;
+    ArrayXd __pairLJEnergyList;
+    ArrayXd __pairCoulombEnergyList;
+    vector<vector<int>> __atomPairIdxList;
+    vector<bool> __movedBoolList;
+    double __ljEnergy;
+    double __coulombEnergy;
+
+
+    // Build Neighbor List
+    void __buildNeighborList();
+
+
+    // Calc Pair Energies
+    void __calcPairEnergies(const vector<int> &pairIdxList, ArrayXd &ljEnergyList, ArrayXd &coulombEnergyList) const;
+
+
+    // Rescore Moved Atoms
+    double __rescoreMovedAtoms(const vector<int> &movedIdxList);
+
+
+    // str
+    string __str() const;
+};
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,396 @@
+/*
+    EnergyScorer.hpp
+    ================
+        Class EnergyScorer implementation.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <cmath>
+#include <stdexcept>
+#include <boost/format.hpp>
+#include <Eigen/Dense>
+#include "EnergyScorer.h"
+#include "Residue.h"
+#include "Atom.h"
+#include "PairExclusion.hpp"
+#include "CellList.hpp"
+#include "Util.hpp"
+#include "Constants.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::pair;
+using std::sqrt;
+using std::runtime_error;
+using boost::format;
+using Eigen::MatrixX3d;
+using Eigen::VectorXd;
+using Eigen::ArrayXd;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Energy Function Parameters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// kcal * A / (mol * e^2)
+const double __COULOMB_CONSTANT = 332.0636;
+
+// Distance-Dependent Dielectric: epsilon(r) = Factor * r
+const double __DIELECTRIC_DISTANCE_FACTOR = 4.;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+EnergyScorer::EnergyScorer(const vector<Atom *> &atomPtrList, double cutoff, double skin, const VectorXd &chargeList,
+    double scale14):
+    __atomPtrList(atomPtrList),
+    __pairExclusion(atomPtrList),
+    __rminList(atomPtrList.size()),
+    __sqrtEpsList(atomPtrList.size()),
+    __chargeList(chargeList),
+    __cutoff(cutoff),
+    __skin(skin),
+    __scale14(scale14),
+    __coordMatrix(atomPtrList.size(), 3),
+    __movedBoolList(atomPtrList.size()),
+    __ljEnergy(0.),
+    __coulombEnergy(0.)
+{
+    if (chargeList.size() && chargeList.size() != (int) atomPtrList.size())
+    {
+        throw runtime_error((format("Charge list size %d does not match atom number %d") %
+            chargeList.size() % atomPtrList.size()).str());
+    }
+
+    if (!chargeList.size())
+    {
+        __chargeList = VectorXd::Zero(atomPtrList.size());
+    }
+
+    for (int atomIdx = 0; atomIdx < (int) atomPtrList.size(); atomIdx++)
+    {
+        auto atomPtr = atomPtrList[atomIdx];
+        auto resPtr  = atomPtr->owner();
+
+        auto ljParamIter = ELEMENT_LJ_PARAM_MAP.find(getElement(atomPtr));
+        auto ljParam     = ljParamIter == ELEMENT_LJ_PARAM_MAP.end() ? __DEFAULT_LJ_PARAM : ljParamIter->second;
+
+        __atomIdxMap[atomPtr]  = atomIdx;
+        __rminList[atomIdx]    = ljParam.first;
+        __sqrtEpsList[atomIdx] = sqrt(ljParam.second);
+
+        if (!chargeList.size())
+        {
+            // Residue Specific Charge First, Then The Backbone Charge
+            for (auto &resName: {resPtr ? resPtr->name() : string(), string("*")})
+            {
+                auto resChargeIter = RESIDUE_ATOM_CHARGE_MAP.find(resName);
+
+                if (resChargeIter != RESIDUE_ATOM_CHARGE_MAP.end() && resChargeIter->second.count(atomPtr->name()))
+                {
+                    __chargeList[atomIdx] = resChargeIter->second.at(atomPtr->name());
+                    break;
+                }
+            }
+        }
+    }
+
+    calcFullEnergy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __cutoff
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double EnergyScorer::cutoff() const
+{
+    return __cutoff;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __chargeList
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const VectorXd &EnergyScorer::chargeList() const
+{
+    return __chargeList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __scale14
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double EnergyScorer::scale14() const
+{
+    return __scale14;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __ljEnergy
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double EnergyScorer::ljEnergy() const
+{
+    return __ljEnergy;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __coulombEnergy
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double EnergyScorer::coulombEnergy() const
+{
+    return __coulombEnergy;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Pair Num (Pairs In The Neighbor List)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int EnergyScorer::pairNum() const
+{
+    return __pairAtomIdxListI.size();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Energy (Rescores Only The Atoms Whose Coord Changed)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double EnergyScorer::calcEnergy()
+{
+    vector<int> movedIdxList;
+
+    for (int atomIdx = 0; atomIdx < (int) __atomPtrList.size(); atomIdx++)
+    {
+        if (__atomPtrList[atomIdx]->coord() != __coordMatrix.row(atomIdx))
+        {
+            __movedBoolList[atomIdx] = true;
+            __coordMatrix.row(atomIdx) = __atomPtrList[atomIdx]->coord();
+            movedIdxList.push_back(atomIdx);
+        }
+    }
+
+    return __rescoreMovedAtoms(movedIdxList);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Energy (Moved Atoms)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double EnergyScorer::calcEnergy(const vector<Atom *> &movedAtomPtrList)
+{
+    vector<int> movedIdxList;
+
+    for (int atomIdx: __getAtomIdxList(__atomIdxMap, movedAtomPtrList, "EnergyScorer"))
+    {
+        if (!__movedBoolList[atomIdx])
+        {
+            __movedBoolList[atomIdx] = true;
+            __coordMatrix.row(atomIdx) = __atomPtrList[atomIdx]->coord();
+            movedIdxList.push_back(atomIdx);
+        }
+    }
+
+    return __rescoreMovedAtoms(movedIdxList);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Full Energy (Rebuilds The Neighbor List)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double EnergyScorer::calcFullEnergy()
+{
+    for (int atomIdx = 0; atomIdx < (int) __atomPtrList.size(); atomIdx++)
+    {
+        __coordMatrix.row(atomIdx) = __atomPtrList[atomIdx]->coord();
+        __movedBoolList[atomIdx]   = false;
+    }
+
+    __buildNeighborList();
+
+    vector<int> pairIdxList(pairNum());
+
+    for (int pairIdx = 0; pairIdx < (int) pairIdxList.size(); pairIdx++)
+    {
+        pairIdxList[pairIdx] = pairIdx;
+    }
+
+    __calcPairEnergies(pairIdxList, __pairLJEnergyList, __pairCoulombEnergyList);
+
+    __ljEnergy      = __pairLJEnergyList.sum();
+    __coulombEnergy = __pairCoulombEnergyList.sum();
+
+    return __ljEnergy + __coulombEnergy;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Build Neighbor List (Verlet List: All Non-Excluded Pairs Within cutoff + skin, 1-4 Pairs Scaled By scale14)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void EnergyScorer::__buildNeighborList()
+{
+    __listCoordMatrix = __coordMatrix;
+
+    __pairAtomIdxListI.clear();
+    __pairAtomIdxListJ.clear();
+    __atomPairIdxList.assign(__atomPtrList.size(), vector<int>());
+
+    if (!__atomPtrList.empty())
+    {
+        double listCutoff = __cutoff + __skin;
+
+        for (auto [atomIdxI, atomIdxJ]: CellList(__coordMatrix, listCutoff).getPairs(listCutoff))
+        {
+            if (!__pairExclusion.isExcludedPair(atomIdxI, atomIdxJ))
+            {
+                __atomPairIdxList[atomIdxI].push_back(__pairAtomIdxListI.size());
+                __atomPairIdxList[atomIdxJ].push_back(__pairAtomIdxListI.size());
+
+                __pairAtomIdxListI.push_back(atomIdxI);
+                __pairAtomIdxListJ.push_back(atomIdxJ);
+            }
+        }
+    }
+
+    int pairNum = __pairAtomIdxListI.size();
+
+    // Combined Per-Pair Parameters, So That The Kernel Is Pure Array Arithmetic
+    __pairSquaredRminList.resize(pairNum);
+    __pairEpsList.resize(pairNum);
+    __pairChargeProductList.resize(pairNum);
+
+    for (int pairIdx = 0; pairIdx < pairNum; pairIdx++)
+    {
+        int atomIdxI = __pairAtomIdxListI[pairIdx], atomIdxJ = __pairAtomIdxListJ[pairIdx];
+        double rmin = __rminList[atomIdxI] + __rminList[atomIdxJ];
+
+        double pairScale = __pairExclusion.is14Pair(atomIdxI, atomIdxJ) ? __scale14 : 1.;
+
+        __pairSquaredRminList[pairIdx]   = rmin * rmin;
+        __pairEpsList[pairIdx]           = pairScale * __sqrtEpsList[atomIdxI] * __sqrtEpsList[atomIdxJ];
+        __pairChargeProductList[pairIdx] = pairScale * __COULOMB_CONSTANT / __DIELECTRIC_DISTANCE_FACTOR *
+            __chargeList[atomIdxI] * __chargeList[atomIdxJ];
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Pair Energies
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void EnergyScorer::__calcPairEnergies(const vector<int> &pairIdxList, ArrayXd &ljEnergyList,
+    ArrayXd &coulombEnergyList) const
+{
+    ArrayXd squaredDisList(pairIdxList.size());
+
+    for (int idx = 0; idx < (int) pairIdxList.size(); idx++)
+    {
+        int pairIdx = pairIdxList[idx];
+
+        squaredDisList[idx] = (__coordMatrix.row(__pairAtomIdxListI[pairIdx]) -
+            __coordMatrix.row(__pairAtomIdxListJ[pairIdx])).squaredNorm();
+    }
+
+    // Vectorized Kernel: E_LJ = eps * ((Rmin / r)^12 - 2 * (Rmin / r)^6), E_Coulomb = k * qi * qj / (4 * r^2)
+    ArrayXd sixthPowerList = (__pairSquaredRminList(pairIdxList) / squaredDisList).cube();
+    auto inCutoffList      = squaredDisList < __cutoff * __cutoff;
+
+    ljEnergyList = inCutoffList.select(
+        __pairEpsList(pairIdxList) * (sixthPowerList.square() - 2. * sixthPowerList), 0.);
+
+    coulombEnergyList = inCutoffList.select(__pairChargeProductList(pairIdxList) / squaredDisList, 0.);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Rescore Moved Atoms (Only Pairs Involving Moved Atoms, Rebuilds The List If An Atom Left The Skin)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double EnergyScorer::__rescoreMovedAtoms(const vector<int> &movedIdxList)
+{
+    double squaredHalfSkin = __skin * __skin / 4.;
+
+    for (int atomIdx: movedIdxList)
+    {
+        if ((__coordMatrix.row(atomIdx) - __listCoordMatrix.row(atomIdx)).squaredNorm() > squaredHalfSkin)
+        {
+            return calcFullEnergy();
+        }
+    }
+
+    vector<int> pairIdxList;
+
+    for (int atomIdx: movedIdxList)
+    {
+        for (int pairIdx: __atomPairIdxList[atomIdx])
+        {
+            int otherAtomIdx = __pairAtomIdxListI[pairIdx] == atomIdx ?
+                __pairAtomIdxListJ[pairIdx] : __pairAtomIdxListI[pairIdx];
+
+            // Pairs Of Two Moved Atoms Only Once
+            if (!__movedBoolList[otherAtomIdx] || otherAtomIdx > atomIdx)
+            {
+                pairIdxList.push_back(pairIdx);
+            }
+        }
+    }
+
+    ArrayXd ljEnergyList, coulombEnergyList;
+
+    __calcPairEnergies(pairIdxList, ljEnergyList, coulombEnergyList);
+
+    __ljEnergy      += ljEnergyList.sum() - __pairLJEnergyList(pairIdxList).sum();
+    __coulombEnergy += coulombEnergyList.sum() - __pairCoulombEnergyList(pairIdxList).sum();
+
+    __pairLJEnergyList(pairIdxList)      = ljEnergyList;
+    __pairCoulombEnergyList(pairIdxList) = coulombEnergyList;
+
+    for (int atomIdx: movedIdxList)
+    {
+        __movedBoolList[atomIdx] = false;
+    }
+
+    return __ljEnergy + __coulombEnergy;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// str
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string EnergyScorer::__str() const
+{
+    return (format("<EnergyScorer object: %d atoms, %d pairs, at %p>") %
+        __atomPtrList.size()                                           %
+        pairNum()                                                      %
+        this
+    ).str();
+}
+
+
+}  // End namespace PDBTools
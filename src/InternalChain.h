@@ -0,0 +1,160 @@
+/*
+    InternalChain.h
+    ===============
+        Class InternalChain header.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <iostream>
+#include <Eigen/Dense>
+#include "Chain.h"
+#include "Residue.h"
+#include "Atom.h"
+#include "Constants.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::pair;
+using std::ostream;
+using Eigen::RowVector3d;
+using Eigen::VectorXd;
+using Eigen::MatrixX3d;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Class InternalChain
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class InternalChain
+{
+    // Friend
+    friend ostream &operator<<(ostream &os, const InternalChain &icObj);
+
+
+public:
+
+    // Constructor
+    explicit InternalChain(Chain *chainPtr, double bondLengthCutoff = 2.);
+
+
+    // Getter: __chainPtr (Sync Cartesian Coord Before Return)
+    Chain *chain();
+
+
+    // Get Atoms
+    const vector<Atom *> &getAtoms();
+
+
+    // Get Atoms Coord
+    const MatrixX3d &getAtomsCoord();
+
+
+    // Calc Backbone Dihedral Angle
+    double calcBBDihedralAngle(int resIdx, DIH dihedralEnum);
+
+
+    // Rotate Backbone Dihedral Angle By Delta Angle
+    InternalChain *rotateBBDihedralAngleByDeltaAngle(int resIdx, DIH dihedralEnum, double deltaAngle);
+
+
+    // Rotate Backbone Dihedral Angle By Target Angle
+    InternalChain *rotateBBDihedralAngleByTargetAngle(int resIdx, DIH dihedralEnum, double targetAngle);
+
+
+    // Calc Side Chain Dihedral Angle
+    double calcSCDihedralAngle(int resIdx, int dihedralIdx);
+
+
+    // Rotate Side Chain Dihedral Angle By Delta Angle
+    InternalChain *rotateSCDihedralAngleByDeltaAngle(int resIdx, int dihedralIdx, double deltaAngle);
+
+
+    // Rotate Side Chain Dihedral Angle By Target Angle
+    InternalChain *rotateSCDihedralAngleByTargetAngle(int resIdx, int dihedralIdx, double targetAngle);
+
+
+    // Get Torsions (Phi, Psi, Chi Of Each Residue In Order, Missing Ones Skipped)
+    VectorXd getTorsions();
+
+
+    // Set Torsions
+    InternalChain *setTorsions(const VectorXd &torsionList);
+
+
+    // Calc Torsion Gradient (dE / dTorsion From dE / dCoord)
+    VectorXd calcTorsionGradient(const MatrixX3d &coordGradMatrix);
+
+
+    // Sync
+    InternalChain *sync();
+
+
+    // Dump
+    InternalChain *dump(const string &dumpFilePath, const string &fileMode = "w");
+
+
+    // Dump Str
+    string dumpStr();
+
+
+private:
+
+    // Data
+    Chain *__chainPtr;
+    vector<Atom *> __atomPtrList;
+    vector<unordered_map<string, int>> __atomIdxMapList;
+    vector<int> __parentIdxList;
+    vector<int> __firstChildIdxList;
+    VectorXd __bondLengthList;
+    VectorXd __bondAngleList;
+    VectorXd __torsionList;
+    VectorXd __torsionOffsetList;
+    MatrixX3d __coordMatrix;
+    int __dirtyIdx;
+    int __unsyncedIdx;
+    vector<int> __torsionAtomIdxList;
+
+
+    // Get Torsion Atom Idx
+    int __getTorsionAtomIdx(const vector<pair<int, string>> &atomKeyList);
+
+
+    // Get Backbone Torsion Atom Idx
+    int __getBBTorsionAtomIdx(int resIdx, DIH dihedralEnum);
+
+
+    // Get Side Chain Torsion Atom Idx
+    int __getSCTorsionAtomIdx(int resIdx, int dihedralIdx);
+
+
+    // Calc Torsion
+    double __calcTorsion(int atomIdx);
+
+
+    // Rotate Torsion
+    InternalChain *__rotateTorsion(int atomIdx, double deltaAngle);
+
+
+    // Materialize
+    void __materialize();
+
+
+    // str
+    string __str() const;
+};
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,538 @@
+/*
+    InternalChain.hpp
+    =================
+        Class InternalChain implementation.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <boost/format.hpp>
+#include <Eigen/Dense>
+#include "InternalChain.h"
+#include "Chain.h"
+#include "Residue.h"
+#include "Atom.h"
+#include "Math.hpp"
+#include "Constants.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::pair;
+using std::min;
+using std::remainder;
+using std::runtime_error;
+using boost::format;
+using Eigen::RowVector3d;
+using Eigen::VectorXd;
+using Eigen::MatrixX3d;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+InternalChain::InternalChain(Chain *chainPtr, double bondLengthCutoff):
+    __chainPtr(chainPtr)
+{
+    vector<int> resStartIdxList;
+
+    for (auto resPtr: *chainPtr)
+    {
+        resStartIdxList.push_back(__atomPtrList.size());
+        __atomIdxMapList.emplace_back();
+
+        for (auto atomPtr: *resPtr)
+        {
+            __atomIdxMapList.back().emplace(atomPtr->name(), __atomPtrList.size());
+            __atomPtrList.push_back(atomPtr);
+        }
+    }
+
+    int atomNum = __atomPtrList.size();
+
+    __coordMatrix.resize(atomNum, 3);
+    __parentIdxList.assign(atomNum, -1);
+    __firstChildIdxList.assign(atomNum, -1);
+    __bondLengthList    = VectorXd::Zero(atomNum);
+    __bondAngleList     = VectorXd::Zero(atomNum);
+    __torsionList       = VectorXd::Zero(atomNum);
+    __torsionOffsetList = VectorXd::Zero(atomNum);
+    __dirtyIdx          = atomNum;
+    __unsyncedIdx       = atomNum;
+
+    for (int atomIdx = 0; atomIdx < atomNum; atomIdx++)
+    {
+        __coordMatrix.row(atomIdx) = __atomPtrList[atomIdx]->coord();
+    }
+
+    // Parent: The Nearest Bonded Atom Before Self (Same Or Previous Residue)
+    for (int resIdx = 0, atomIdx = 0; resIdx < (int) resStartIdxList.size(); resIdx++)
+    {
+        int searchStartIdx = resStartIdxList[resIdx > 0 ? resIdx - 1 : 0];
+
+        for (; atomIdx < atomNum && (resIdx + 1 == (int) resStartIdxList.size() ||
+            atomIdx < resStartIdxList[resIdx + 1]); atomIdx++)
+        {
+            double minSquaredDis = bondLengthCutoff * bondLengthCutoff;
+
+            for (int searchIdx = searchStartIdx; searchIdx < atomIdx; searchIdx++)
+            {
+                double squaredDis = (__coordMatrix.row(atomIdx) - __coordMatrix.row(searchIdx)).squaredNorm();
+
+                if (squaredDis < minSquaredDis)
+                {
+                    minSquaredDis = squaredDis;
+                    __parentIdxList[atomIdx] = searchIdx;
+                }
+            }
+
+            int parentIdx = __parentIdxList[atomIdx];
+
+            if (parentIdx >= 0 && __firstChildIdxList[parentIdx] < 0)
+            {
+                __firstChildIdxList[parentIdx] = atomIdx;
+            }
+        }
+    }
+
+    // Internal Coord: Torsion Of Bond (B => C) Is Shared By All Children Of C
+    for (int atomIdx = 0; atomIdx < atomNum; atomIdx++)
+    {
+        int idxC = __parentIdxList[atomIdx];
+        int idxB = idxC >= 0 ? __parentIdxList[idxC] : -1;
+        int idxA = idxB >= 0 ? __parentIdxList[idxB] : -1;
+
+        if (idxA < 0)
+        {
+            continue;
+        }
+
+        RowVector3d coordA = __coordMatrix.row(idxA);
+        RowVector3d coordB = __coordMatrix.row(idxB);
+        RowVector3d coordC = __coordMatrix.row(idxC);
+        RowVector3d coordD = __coordMatrix.row(atomIdx);
+
+        __bondLengthList[atomIdx] = (coordD - coordC).norm();
+        __bondAngleList[atomIdx]  = calcVectorAngle(coordB - coordC, coordD - coordC);
+
+        double dihedralAngle = calcDihedralAngle(coordA, coordB, coordC, coordD);
+
+        if (__firstChildIdxList[idxC] == atomIdx)
+        {
+            __torsionList[idxC] = dihedralAngle;
+        }
+        else
+        {
+            __torsionOffsetList[atomIdx] = dihedralAngle - __torsionList[idxC];
+        }
+    }
+
+    // Torsion Degrees Of Freedom (Missing Atoms Or Chain Termini Throw, And Are Skipped)
+    for (int resIdx = 0; resIdx < (int) __atomIdxMapList.size(); resIdx++)
+    {
+        for (auto dihedralEnum: {DIH::PHI, DIH::PSI})
+        {
+            try
+            {
+                __torsionAtomIdxList.push_back(__getBBTorsionAtomIdx(resIdx, dihedralEnum));
+            }
+            catch (const runtime_error &)
+            {
+            }
+        }
+
+        auto rotationAtomsNameIter = __RESIDUE_SIDE_CHAIN_ROTATION_ATOMS_NAME_MAP.find(
+            __chainPtr->sub()[resIdx]->name());
+
+        if (rotationAtomsNameIter == __RESIDUE_SIDE_CHAIN_ROTATION_ATOMS_NAME_MAP.end())
+        {
+            continue;
+        }
+
+        for (int dihedralIdx = 0; dihedralIdx < (int) rotationAtomsNameIter->second.size(); dihedralIdx++)
+        {
+            try
+            {
+                __torsionAtomIdxList.push_back(__getSCTorsionAtomIdx(resIdx, dihedralIdx));
+            }
+            catch (const runtime_error &)
+            {
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __chainPtr (Sync Cartesian Coord Before Return)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Chain *InternalChain::chain()
+{
+    sync();
+
+    return __chainPtr;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Atoms
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const vector<Atom *> &InternalChain::getAtoms()
+{
+    return __atomPtrList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Atoms Coord
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const MatrixX3d &InternalChain::getAtomsCoord()
+{
+    __materialize();
+
+    return __coordMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Backbone Dihedral Angle
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double InternalChain::calcBBDihedralAngle(int resIdx, DIH dihedralEnum)
+{
+    return __calcTorsion(__getBBTorsionAtomIdx(resIdx, dihedralEnum));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Rotate Backbone Dihedral Angle By Delta Angle
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+InternalChain *InternalChain::rotateBBDihedralAngleByDeltaAngle(int resIdx, DIH dihedralEnum, double deltaAngle)
+{
+    return __rotateTorsion(__getBBTorsionAtomIdx(resIdx, dihedralEnum), deltaAngle);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Rotate Backbone Dihedral Angle By Target Angle
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+InternalChain *InternalChain::rotateBBDihedralAngleByTargetAngle(int resIdx, DIH dihedralEnum, double targetAngle)
+{
+    int atomIdx = __getBBTorsionAtomIdx(resIdx, dihedralEnum);
+
+    return __rotateTorsion(atomIdx, targetAngle - __calcTorsion(atomIdx));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Side Chain Dihedral Angle
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double InternalChain::calcSCDihedralAngle(int resIdx, int dihedralIdx)
+{
+    return __calcTorsion(__getSCTorsionAtomIdx(resIdx, dihedralIdx));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Rotate Side Chain Dihedral Angle By Delta Angle
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+InternalChain *InternalChain::rotateSCDihedralAngleByDeltaAngle(int resIdx, int dihedralIdx, double deltaAngle)
+{
+    return __rotateTorsion(__getSCTorsionAtomIdx(resIdx, dihedralIdx), deltaAngle);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Rotate Side Chain Dihedral Angle By Target Angle
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+InternalChain *InternalChain::rotateSCDihedralAngleByTargetAngle(int resIdx, int dihedralIdx, double targetAngle)
+{
+    int atomIdx = __getSCTorsionAtomIdx(resIdx, dihedralIdx);
+
+    return __rotateTorsion(atomIdx, targetAngle - __calcTorsion(atomIdx));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Torsions (Phi, Psi, Chi Of Each Residue In Order, Missing Ones Skipped)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorXd InternalChain::getTorsions()
+{
+    VectorXd torsionList(__torsionAtomIdxList.size());
+
+    for (int torsionIdx = 0; torsionIdx < torsionList.size(); torsionIdx++)
+    {
+        torsionList[torsionIdx] = __calcTorsion(__torsionAtomIdxList[torsionIdx]);
+    }
+
+    return torsionList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Set Torsions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+InternalChain *InternalChain::setTorsions(const VectorXd &torsionList)
+{
+    if (torsionList.size() != (int) __torsionAtomIdxList.size())
+    {
+        throw runtime_error((format("Torsion list size %d does not match torsion number %d") %
+            torsionList.size() % __torsionAtomIdxList.size()).str());
+    }
+
+    for (int torsionIdx = 0; torsionIdx < torsionList.size(); torsionIdx++)
+    {
+        int atomIdx = __torsionAtomIdxList[torsionIdx];
+
+        __rotateTorsion(atomIdx, torsionList[torsionIdx] - __calcTorsion(atomIdx));
+    }
+
+    return this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Torsion Gradient (Abe-Go Recursion, O(N))
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorXd InternalChain::calcTorsionGradient(const MatrixX3d &coordGradMatrix)
+{
+    __materialize();
+
+    int atomNum = __atomPtrList.size();
+
+    // Subtree Sums Of g And r x g, Accumulated From The Leaves (Children Always Follow Their Parent)
+    MatrixX3d gradSumMatrix = coordGradMatrix, momentSumMatrix(atomNum, 3);
+
+    for (int atomIdx = 0; atomIdx < atomNum; atomIdx++)
+    {
+        momentSumMatrix.row(atomIdx) = __coordMatrix.row(atomIdx).cross(coordGradMatrix.row(atomIdx));
+    }
+
+    for (int atomIdx = atomNum - 1; atomIdx >= 0; atomIdx--)
+    {
+        int parentIdx = __parentIdxList[atomIdx];
+
+        if (parentIdx >= 0)
+        {
+            gradSumMatrix.row(parentIdx)   += gradSumMatrix.row(atomIdx);
+            momentSumMatrix.row(parentIdx) += momentSumMatrix.row(atomIdx);
+        }
+    }
+
+    VectorXd torsionGradList(__torsionAtomIdxList.size());
+
+    for (int torsionIdx = 0; torsionIdx < torsionGradList.size(); torsionIdx++)
+    {
+        int idxC = __parentIdxList[__torsionAtomIdxList[torsionIdx]];
+        int idxB = __parentIdxList[idxC];
+
+        // The Torsion Of Bond (B => C) Rotates All Descendants Of C About The Axis: dr / dTorsion = e x (r - C)
+        RowVector3d coordC    = __coordMatrix.row(idxC);
+        RowVector3d gradSum   = gradSumMatrix.row(idxC) - coordGradMatrix.row(idxC);
+        RowVector3d momentSum = momentSumMatrix.row(idxC) - coordC.cross(coordGradMatrix.row(idxC));
+
+        torsionGradList[torsionIdx] = (coordC - __coordMatrix.row(idxB)).normalized().dot(
+            momentSum - coordC.cross(gradSum));
+    }
+
+    return torsionGradList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Sync
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+InternalChain *InternalChain::sync()
+{
+    __materialize();
+
+    for (int atomIdx = __unsyncedIdx; atomIdx < (int) __atomPtrList.size(); atomIdx++)
+    {
+        __atomPtrList[atomIdx]->coord(__coordMatrix.row(atomIdx));
+    }
+
+    __unsyncedIdx = __atomPtrList.size();
+
+    return this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Dump
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+InternalChain *InternalChain::dump(const string &dumpFilePath, const string &fileMode)
+{
+    chain()->dump(dumpFilePath, fileMode);
+
+    return this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Dump Str
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string InternalChain::dumpStr()
+{
+    return chain()->dumpStr();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Torsion Atom Idx
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int InternalChain::__getTorsionAtomIdx(const vector<pair<int, string>> &atomKeyList)
+{
+    vector<int> atomIdxList;
+
+    for (auto &[resIdx, atomName]: atomKeyList)
+    {
+        if (resIdx < 0 || resIdx >= (int) __atomIdxMapList.size() || !__atomIdxMapList[resIdx].count(atomName))
+        {
+            throw runtime_error((format("Atom %s of residue %d not exists") % atomName % resIdx).str());
+        }
+
+        atomIdxList.push_back(__atomIdxMapList[resIdx].at(atomName));
+    }
+
+    for (int idx = 3; idx > 0; idx--)
+    {
+        if (__parentIdxList[atomIdxList[idx]] != atomIdxList[idx - 1])
+        {
+            throw runtime_error("Dihedral angle is not a torsion of the internal coordinate tree");
+        }
+    }
+
+    return atomIdxList[3];
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Backbone Torsion Atom Idx
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int InternalChain::__getBBTorsionAtomIdx(int resIdx, DIH dihedralEnum)
+{
+    if (dihedralEnum == DIH::L)
+    {
+        return __getTorsionAtomIdx({{resIdx - 1, "C"}, {resIdx, "N"}, {resIdx, "CA"}, {resIdx, "C"}});
+    }
+    else
+    {
+        return __getTorsionAtomIdx({{resIdx, "N"}, {resIdx, "CA"}, {resIdx, "C"}, {resIdx + 1, "N"}});
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Side Chain Torsion Atom Idx
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int InternalChain::__getSCTorsionAtomIdx(int resIdx, int dihedralIdx)
+{
+    auto &atomNameList = __RESIDUE_SIDE_CHAIN_ROTATION_ATOMS_NAME_MAP.at(
+        __chainPtr->sub().at(resIdx)->name()).at(dihedralIdx);
+
+    return __getTorsionAtomIdx({{resIdx, atomNameList[0]}, {resIdx, atomNameList[1]},
+        {resIdx, atomNameList[2]}, {resIdx, atomNameList[3]}});
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Torsion
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double InternalChain::__calcTorsion(int atomIdx)
+{
+    return remainder(__torsionList[__parentIdxList[atomIdx]] + __torsionOffsetList[atomIdx], 2. * M_PI);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Rotate Torsion
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+InternalChain *InternalChain::__rotateTorsion(int atomIdx, double deltaAngle)
+{
+    int parentIdx = __parentIdxList[atomIdx];
+
+    __torsionList[parentIdx] += deltaAngle;
+    __dirtyIdx = min(__dirtyIdx, __firstChildIdxList[parentIdx]);
+
+    return this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Materialize (Rebuild The Dirty Suffix Only)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void InternalChain::__materialize()
+{
+    int atomNum = __atomPtrList.size();
+
+    for (int atomIdx = __dirtyIdx; atomIdx < atomNum; atomIdx++)
+    {
+        int idxC = __parentIdxList[atomIdx];
+        int idxB = idxC >= 0 ? __parentIdxList[idxC] : -1;
+        int idxA = idxB >= 0 ? __parentIdxList[idxB] : -1;
+
+        if (idxA < 0)
+        {
+            continue;
+        }
+
+        __coordMatrix.row(atomIdx) = calcCoordByInternalCoord(
+            __coordMatrix.row(idxA), __coordMatrix.row(idxB), __coordMatrix.row(idxC),
+            __bondLengthList[atomIdx], __bondAngleList[atomIdx],
+            __torsionList[idxC] + __torsionOffsetList[atomIdx]);
+    }
+
+    __unsyncedIdx = min(__unsyncedIdx, __dirtyIdx);
+    __dirtyIdx    = atomNum;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// str
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string InternalChain::__str() const
+{
+    return (format("<InternalChain object: %s, at %p>") %
+        __chainPtr->name()                                %
+        this
+    ).str();
+}
+
+
+}  // End namespace PDBTools
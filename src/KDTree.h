@@ -0,0 +1,121 @@
+/*
+    KDTree.h
+    ========
+        Class KDTree header.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <Eigen/Dense>
+#include "Predecl.h"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::pair;
+using std::ostream;
+using Eigen::RowVector3d;
+using Eigen::MatrixX3d;
+using Eigen::MatrixXi;
+using Eigen::MatrixXd;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Class KDTree
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class KDTree
+{
+    // Friend
+    friend ostream &operator<<(ostream &os, const KDTree &kdTreeObj);
+
+
+public:
+
+    // Constructor
+    explicit KDTree(const MatrixX3d &coordMatrix, int leafSize = 16);
+
+
+    // Constructor (Atom List)
+    explicit KDTree(const vector<Atom *> &atomPtrList, int leafSize = 16);
+
+
+    // Constructor (Residue List, By Residue Center)
+    explicit KDTree(const vector<Residue *> &resPtrList, int leafSize = 16);
+
+
+    // Getter: __coordMatrix
+    const MatrixX3d &coordMatrix() const;
+
+
+    // Size
+    int size() const;
+
+
+    // Query K Nearest
+    pair<vector<int>, vector<double>> queryKNearest(const RowVector3d &coord, int k) const;
+
+
+    // Query Radius
+    vector<int> queryRadius(const RowVector3d &coord, double radius) const;
+
+
+    // Batch Query K Nearest
+    pair<MatrixXi, MatrixXd> batchQueryKNearest(const MatrixX3d &coordMatrix, int k) const;
+
+
+    // Batch Query Radius
+    vector<vector<int>> batchQueryRadius(const MatrixX3d &coordMatrix, double radius) const;
+
+
+private:
+
+    // Node
+    struct __Node
+    {
+        int startIdx;
+        int endIdx;
+        int splitDim;
+        double splitValue;
+        int leftIdx;
+        int rightIdx;
+    };
+
+
+    // Data
+    MatrixX3d __coordMatrix;
+    MatrixX3d __sortedCoordMatrix;
+    vector<int> __sortedIdxList;
+    vector<__Node> __nodeList;
+    int __leafSize;
+
+
+    // Build
+    int __build(int startIdx, int endIdx);
+
+
+    // Query K Nearest (Recursive)
+    template <typename Heap>
+    void __queryKNearest(int nodeIdx, const RowVector3d &coord, int k, Heap &resultHeap) const;
+
+
+    // Query Radius (Recursive)
+    void __queryRadius(int nodeIdx, const RowVector3d &coord, double squaredRadius, vector<int> &atomIdxList) const;
+
+
+    // str
+    string __str() const;
+};
+
+
+}  // End namespace PDBTools
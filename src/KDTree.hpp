@@ -0,0 +1,366 @@
+/*
+    KDTree.hpp
+    ==========
+        Class KDTree implementation.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <queue>
+#include <limits>
+#include <cmath>
+#include <boost/format.hpp>
+#include <Eigen/Dense>
+#include "KDTree.h"
+#include "Residue.h"
+#include "Atom.h"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::pair;
+using std::max;
+using std::nth_element;
+using std::priority_queue;
+using std::numeric_limits;
+using std::sqrt;
+using boost::format;
+using Eigen::RowVector3d;
+using Eigen::MatrixX3d;
+using Eigen::MatrixXi;
+using Eigen::MatrixXd;
+using Eigen::Index;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+KDTree::KDTree(const MatrixX3d &coordMatrix, int leafSize):
+    __coordMatrix(coordMatrix),
+    __sortedIdxList(coordMatrix.rows()),
+    __leafSize(max(leafSize, 1))
+{
+    for (int idx = 0; idx < (int) __sortedIdxList.size(); idx++)
+    {
+        __sortedIdxList[idx] = idx;
+    }
+
+    if (!__sortedIdxList.empty())
+    {
+        __nodeList.reserve(2 * (__sortedIdxList.size() / __leafSize + 1));
+        __build(0, __sortedIdxList.size());
+    }
+
+    // Leaf Coordinates Are Stored Contiguously To Keep Leaf Scans In Cache
+    __sortedCoordMatrix.resize(__sortedIdxList.size(), 3);
+
+    for (int idx = 0; idx < (int) __sortedIdxList.size(); idx++)
+    {
+        __sortedCoordMatrix.row(idx) = __coordMatrix.row(__sortedIdxList[idx]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor (Atom List)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+KDTree::KDTree(const vector<Atom *> &atomPtrList, int leafSize):
+    KDTree(
+        [&atomPtrList]()
+        {
+            MatrixX3d coordMatrix(atomPtrList.size(), 3);
+
+            for (int idx = 0; idx < (int) atomPtrList.size(); idx++)
+            {
+                coordMatrix.row(idx) = atomPtrList[idx]->coord();
+            }
+
+            return coordMatrix;
+        }(),
+        leafSize) {}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor (Residue List, By Residue Center)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+KDTree::KDTree(const vector<Residue *> &resPtrList, int leafSize):
+    KDTree(
+        [&resPtrList]()
+        {
+            MatrixX3d coordMatrix(resPtrList.size(), 3);
+
+            for (int idx = 0; idx < (int) resPtrList.size(); idx++)
+            {
+                coordMatrix.row(idx) = resPtrList[idx]->center();
+            }
+
+            return coordMatrix;
+        }(),
+        leafSize) {}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __coordMatrix
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const MatrixX3d &KDTree::coordMatrix() const
+{
+    return __coordMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Size
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int KDTree::size() const
+{
+    return __coordMatrix.rows();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Query K Nearest
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+pair<vector<int>, vector<double>> KDTree::queryKNearest(const RowVector3d &coord, int k) const
+{
+    // Max Heap Of (Squared Distance, Idx)
+    priority_queue<pair<double, int>> resultHeap;
+
+    if (!__nodeList.empty() && k > 0)
+    {
+        __queryKNearest(0, coord, k, resultHeap);
+    }
+
+    vector<int> idxList(resultHeap.size());
+    vector<double> disList(resultHeap.size());
+
+    for (int idx = resultHeap.size() - 1; idx >= 0; idx--)
+    {
+        idxList[idx] = resultHeap.top().second;
+        disList[idx] = sqrt(resultHeap.top().first);
+
+        resultHeap.pop();
+    }
+
+    return {idxList, disList};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Query Radius
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<int> KDTree::queryRadius(const RowVector3d &coord, double radius) const
+{
+    vector<int> idxList;
+
+    if (!__nodeList.empty())
+    {
+        __queryRadius(0, coord, radius * radius, idxList);
+    }
+
+    return idxList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Batch Query K Nearest
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+pair<MatrixXi, MatrixXd> KDTree::batchQueryKNearest(const MatrixX3d &coordMatrix, int k) const
+{
+    // Rows Are Padded With -1 / inf When The Tree Has Fewer Than k Points
+    MatrixXi idxMatrix = MatrixXi::Constant(coordMatrix.rows(), k, -1);
+    MatrixXd disMatrix = MatrixXd::Constant(coordMatrix.rows(), k, numeric_limits<double>::infinity());
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int queryIdx = 0; queryIdx < coordMatrix.rows(); queryIdx++)
+    {
+        auto [idxList, disList] = queryKNearest(coordMatrix.row(queryIdx), k);
+
+        for (int idx = 0; idx < (int) idxList.size(); idx++)
+        {
+            idxMatrix(queryIdx, idx) = idxList[idx];
+            disMatrix(queryIdx, idx) = disList[idx];
+        }
+    }
+
+    return {idxMatrix, disMatrix};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Batch Query Radius
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<vector<int>> KDTree::batchQueryRadius(const MatrixX3d &coordMatrix, double radius) const
+{
+    vector<vector<int>> idxListList(coordMatrix.rows());
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int queryIdx = 0; queryIdx < coordMatrix.rows(); queryIdx++)
+    {
+        idxListList[queryIdx] = queryRadius(coordMatrix.row(queryIdx), radius);
+    }
+
+    return idxListList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Build (Median Split Along The Widest Dimension)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int KDTree::__build(int startIdx, int endIdx)
+{
+    int nodeIdx = __nodeList.size();
+
+    __nodeList.push_back({startIdx, endIdx, -1, 0., -1, -1});
+
+    if (endIdx - startIdx <= __leafSize)
+    {
+        return nodeIdx;
+    }
+
+    RowVector3d minCoord = __coordMatrix.row(__sortedIdxList[startIdx]), maxCoord = minCoord;
+
+    for (int idx = startIdx + 1; idx < endIdx; idx++)
+    {
+        minCoord = minCoord.cwiseMin(__coordMatrix.row(__sortedIdxList[idx]));
+        maxCoord = maxCoord.cwiseMax(__coordMatrix.row(__sortedIdxList[idx]));
+    }
+
+    Index splitDim;
+    (maxCoord - minCoord).maxCoeff(&splitDim);
+
+    int midIdx = (startIdx + endIdx) / 2;
+
+    nth_element(__sortedIdxList.begin() + startIdx, __sortedIdxList.begin() + midIdx,
+        __sortedIdxList.begin() + endIdx, [&](int idxA, int idxB)
+        {
+            return __coordMatrix(idxA, splitDim) < __coordMatrix(idxB, splitDim);
+        });
+
+    __nodeList[nodeIdx].splitDim   = splitDim;
+    __nodeList[nodeIdx].splitValue = __coordMatrix(__sortedIdxList[midIdx], splitDim);
+
+    // __nodeList May Reallocate During Recursion, So Children Are Assigned By Index
+    int leftIdx  = __build(startIdx, midIdx);
+    int rightIdx = __build(midIdx, endIdx);
+
+    __nodeList[nodeIdx].leftIdx  = leftIdx;
+    __nodeList[nodeIdx].rightIdx = rightIdx;
+
+    return nodeIdx;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Query K Nearest (Recursive)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Heap>
+void KDTree::__queryKNearest(int nodeIdx, const RowVector3d &coord, int k, Heap &resultHeap) const
+{
+    const __Node &nodeObj = __nodeList[nodeIdx];
+
+    if (nodeObj.splitDim < 0)
+    {
+        for (int idx = nodeObj.startIdx; idx < nodeObj.endIdx; idx++)
+        {
+            double squaredDis = (__sortedCoordMatrix.row(idx) - coord).squaredNorm();
+
+            if ((int) resultHeap.size() < k)
+            {
+                resultHeap.emplace(squaredDis, __sortedIdxList[idx]);
+            }
+            else if (squaredDis < resultHeap.top().first)
+            {
+                resultHeap.pop();
+                resultHeap.emplace(squaredDis, __sortedIdxList[idx]);
+            }
+        }
+
+        return;
+    }
+
+    double splitDis = coord[nodeObj.splitDim] - nodeObj.splitValue;
+
+    int nearIdx = splitDis < 0. ? nodeObj.leftIdx : nodeObj.rightIdx;
+    int farIdx  = splitDis < 0. ? nodeObj.rightIdx : nodeObj.leftIdx;
+
+    __queryKNearest(nearIdx, coord, k, resultHeap);
+
+    if ((int) resultHeap.size() < k || splitDis * splitDis < resultHeap.top().first)
+    {
+        __queryKNearest(farIdx, coord, k, resultHeap);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Query Radius (Recursive)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void KDTree::__queryRadius(int nodeIdx, const RowVector3d &coord, double squaredRadius,
+    vector<int> &atomIdxList) const
+{
+    const __Node &nodeObj = __nodeList[nodeIdx];
+
+    if (nodeObj.splitDim < 0)
+    {
+        for (int idx = nodeObj.startIdx; idx < nodeObj.endIdx; idx++)
+        {
+            if ((__sortedCoordMatrix.row(idx) - coord).squaredNorm() <= squaredRadius)
+            {
+                atomIdxList.push_back(__sortedIdxList[idx]);
+            }
+        }
+
+        return;
+    }
+
+    double splitDis = coord[nodeObj.splitDim] - nodeObj.splitValue;
+
+    if (splitDis < 0. || splitDis * splitDis <= squaredRadius)
+    {
+        __queryRadius(nodeObj.leftIdx, coord, squaredRadius, atomIdxList);
+    }
+
+    if (splitDis >= 0. || splitDis * splitDis <= squaredRadius)
+    {
+        __queryRadius(nodeObj.rightIdx, coord, squaredRadius, atomIdxList);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// str
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string KDTree::__str() const
+{
+    return (format("<KDTree object: %d points, %d nodes, at %p>") %
+        __coordMatrix.rows()                                    %
+        __nodeList.size()                                       %
+        this
+    ).str();
+}
+
+
+}  // End namespace PDBTools
@@ -10,6 +10,10 @@
 #include <vector>
 #include <algorithm>
 #include <tuple>
+#include <utility>
+#include <stdexcept>
+#include <random>
+#include <boost/format.hpp>
 #include <Eigen/Dense>
 
 namespace PDBTools
@@ -23,10 +27,23 @@ using std::vector;
 using std::min;
 using std::max;
 using std::tuple;
+using std::pair;
+using std::runtime_error;
+using std::mt19937;
+using std::normal_distribution;
+using boost::format;
 using Eigen::RowVector3d;
 using Eigen::Matrix3d;
+using Eigen::VectorXd;
 using Eigen::MatrixX3d;
+using Eigen::MatrixXd;
+using Eigen::ArrayXd;
+using Eigen::ArrayX3d;
+using Eigen::Ref;
+using Eigen::Array;
+using Eigen::Dynamic;
 using Eigen::JacobiSVD;
+using Eigen::HouseholderQR;
 using Eigen::ComputeFullU;
 using Eigen::ComputeFullV;
 
@@ -96,51 +113,108 @@ Matrix3d calcRotationMatrixByTwoVector(const RowVector3d &tarCoord, const RowVec
 double calcDihedralAngle(const RowVector3d &coordA, const RowVector3d &coordB, const RowVector3d &coordC, const RowVector3d &coordD)
 {
     RowVector3d AB = coordB - coordA;
-    RowVector3d AC = coordC - coordA;
-    RowVector3d DB = coordB - coordD;
-    RowVector3d DC = coordC - coordD;
+    RowVector3d BC = coordC - coordB;
+    RowVector3d CD = coordD - coordC;
 
-    RowVector3d ABAC = AB.cross(AC);
-    RowVector3d DBDC = DB.cross(DC);
+    RowVector3d BCCD = BC.cross(CD);
 
-    double dihedralAngle = calcVectorAngle(ABAC, DBDC);
+    return atan2(BC.norm() * AB.dot(BCCD), AB.cross(BC).dot(BCCD));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Rowwise Dihedral Angle
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorXd calcRowwiseDihedralAngle(const Ref<const MatrixX3d> &coordMatrixA, const Ref<const MatrixX3d> &coordMatrixB,
+    const Ref<const MatrixX3d> &coordMatrixC, const Ref<const MatrixX3d> &coordMatrixD)
+{
+    ArrayX3d AB = coordMatrixB - coordMatrixA;
+    ArrayX3d BC = coordMatrixC - coordMatrixB;
+    ArrayX3d CD = coordMatrixD - coordMatrixC;
+
+    ArrayX3d ABBC(AB.rows(), 3), BCCD(BC.rows(), 3);
+
+    ABBC.col(0) = AB.col(1) * BC.col(2) - AB.col(2) * BC.col(1);
+    ABBC.col(1) = AB.col(2) * BC.col(0) - AB.col(0) * BC.col(2);
+    ABBC.col(2) = AB.col(0) * BC.col(1) - AB.col(1) * BC.col(0);
+
+    BCCD.col(0) = BC.col(1) * CD.col(2) - BC.col(2) * CD.col(1);
+    BCCD.col(1) = BC.col(2) * CD.col(0) - BC.col(0) * CD.col(2);
+    BCCD.col(2) = BC.col(0) * CD.col(1) - BC.col(1) * CD.col(0);
+
+    ArrayXd Y = BC.square().rowwise().sum().sqrt() * (AB * BCCD).rowwise().sum();
+    ArrayXd X = (ABBC * BCCD).rowwise().sum();
+
+    return Y.binaryExpr(X, [](double y, double x) { return atan2(y, x); });
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Coord By Internal Coord (NeRF)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    // Calc Sign
-    RowVector3d OA = coordA - coordB;
-    RowVector3d OC = coordC - coordB;
-    RowVector3d OD = coordD - coordB;
+RowVector3d calcCoordByInternalCoord(const RowVector3d &coordA, const RowVector3d &coordB, const RowVector3d &coordC,
+    double bondLength, double bondAngle, double dihedralAngle)
+{
+    RowVector3d BC = (coordC - coordB).normalized();
+    RowVector3d N  = (coordB - coordA).cross(BC).normalized();
 
-    double rotationAngle = calcVectorAngle(OC, RowVector3d(1., 0., 0.));
+    double bondLengthSin = bondLength * sin(bondAngle);
 
-    Matrix3d rotationMatrix = calcRotationMatrix(OC.cross(RowVector3d(1., 0., 0.)), rotationAngle);
+    return coordC - BC * (bondLength * cos(bondAngle)) +
+        N.cross(BC) * (bondLengthSin * cos(dihedralAngle)) + N * (bondLengthSin * sin(dihedralAngle));
+}
 
-    OA *= rotationMatrix;
-    OD *= rotationMatrix;
 
-    OA[0] = 0.;
-    OD[0] = 0.;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc RMSD (Root-Mean-Square Deviation)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    rotationAngle  = calcVectorAngle(OA, RowVector3d(0., 0., 1.));
-    rotationMatrix = calcRotationMatrix(OA.cross(RowVector3d(0., 0., 1.)), rotationAngle);
+double calcRMSD(const Ref<const MatrixX3d> &coordMatrixA, const Ref<const MatrixX3d> &coordMatrixB)
+{
+    return sqrt((coordMatrixA - coordMatrixB).squaredNorm() / coordMatrixA.rows());
+}
 
-    OD *= rotationMatrix;
 
-    if (OD[1] > 0.)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Kabsch Rotation Matrix (From Centered Covariance Matrix)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Matrix3d __calcKabschRotationMatrix(const Matrix3d &covMatrix)
+{
+    JacobiSVD<Matrix3d> svd(covMatrix, ComputeFullU | ComputeFullV);
+
+    Matrix3d U = svd.matrixU(), V = svd.matrixV().transpose();
+
+    if (U.determinant() * V.determinant() < 0.)
     {
-        dihedralAngle = -dihedralAngle;
+        U.col(2) = -U.col(2);
     }
 
-    return dihedralAngle;
+    return U * V;
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Calc RMSD (Root-Mean-Square Deviation)
+// Calc Superimpose Statistics (Centers, Centered Covariance Matrix And Inner Products, Without Copying The Coords)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-double calcRMSD(const MatrixX3d &coordMatrixA, const MatrixX3d &coordMatrixB)
+tuple<RowVector3d, RowVector3d, Matrix3d, double, double> __calcSuperimposeStatistics(
+    const Ref<const MatrixX3d> &tarCoordMatrix, const Ref<const MatrixX3d> &srcCoordMatrix)
 {
-    return sqrt((coordMatrixA - coordMatrixB).array().square().sum() / coordMatrixA.rows());
+    RowVector3d srcCenterCoord = srcCoordMatrix.colwise().mean();
+    RowVector3d tarCenterCoord = tarCoordMatrix.colwise().mean();
+
+    int atomNum = tarCoordMatrix.rows();
+
+    Matrix3d covMatrix = srcCoordMatrix.transpose().lazyProduct(tarCoordMatrix) -
+        atomNum * srcCenterCoord.transpose() * tarCenterCoord;
+
+    double tarInnerProduct = tarCoordMatrix.squaredNorm() - atomNum * tarCenterCoord.squaredNorm();
+    double srcInnerProduct = srcCoordMatrix.squaredNorm() - atomNum * srcCenterCoord.squaredNorm();
+
+    return {srcCenterCoord, tarCenterCoord, covMatrix, tarInnerProduct, srcInnerProduct};
 }
 
 
@@ -149,36 +223,384 @@ double calcRMSD(const MatrixX3d &coordMatrixA, const MatrixX3d &coordMatrixB)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 tuple<RowVector3d, Matrix3d, RowVector3d> calcSuperimposeRotationMatrix(
-    const MatrixX3d &tarCoordMatrix, const MatrixX3d &srcCoordMatrix)
+    const Ref<const MatrixX3d> &tarCoordMatrix, const Ref<const MatrixX3d> &srcCoordMatrix)
 {
-    RowVector3d srcCenterCoord = srcCoordMatrix.colwise().mean();
-    RowVector3d tarCenterCoord = tarCoordMatrix.colwise().mean();
+    auto [srcCenterCoord, tarCenterCoord, covMatrix, tarInnerProduct, srcInnerProduct] =
+        __calcSuperimposeStatistics(tarCoordMatrix, srcCoordMatrix);
 
-    JacobiSVD<Matrix3d> svd((srcCoordMatrix.rowwise() - srcCenterCoord).transpose() *
-        (tarCoordMatrix.rowwise() - tarCenterCoord), ComputeFullU | ComputeFullV);
+    return {srcCenterCoord, __calcKabschRotationMatrix(covMatrix), tarCenterCoord};
+}
 
-    Matrix3d U = svd.matrixU(), V = svd.matrixV().transpose();
 
-    if (U.determinant() * V.determinant() < 0.)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc RMSD After Superimpose A <= B
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double calcRMSDAfterSuperimpose(const Ref<const MatrixX3d> &tarCoordMatrix, const Ref<const MatrixX3d> &srcCoordMatrix)
+{
+    auto [srcCenterCoord, tarCenterCoord, covMatrix, tarInnerProduct, srcInnerProduct] =
+        __calcSuperimposeStatistics(tarCoordMatrix, srcCoordMatrix);
+
+    // sum |(src - srcCenter) * R - (tar - tarCenter)|^2 = Gt + Gs - 2 * tr(R^T * cov)
+    double squaredDeviation = tarInnerProduct + srcInnerProduct -
+        2. * __calcKabschRotationMatrix(covMatrix).cwiseProduct(covMatrix).sum();
+
+    return sqrt(max(squaredDeviation, 0.) / tarCoordMatrix.rows());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Orthonormalize Columns (Thin Q Of A Householder QR)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MatrixXd __orthonormalizeColumns(const MatrixXd &inputMatrix)
+{
+    HouseholderQR<MatrixXd> qrSolver(inputMatrix);
+
+    return qrSolver.householderQ() * MatrixXd::Identity(inputMatrix.rows(), inputMatrix.cols());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Random Normal Matrix (Seeded, Reproducible)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MatrixXd __calcRandomNormalMatrix(int rowNum, int colNum, unsigned randomSeed)
+{
+    mt19937 randomEngine(randomSeed);
+    normal_distribution<double> normalDistribution;
+
+    return MatrixXd::NullaryExpr(rowNum, colNum, [&]() { return normalDistribution(randomEngine); });
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Weighted Superimpose Statistics
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+tuple<RowVector3d, RowVector3d, Matrix3d, double, double> __calcWeightedSuperimposeStatistics(
+    const Ref<const MatrixX3d> &tarCoordMatrix, const Ref<const MatrixX3d> &srcCoordMatrix,
+    const Ref<const VectorXd> &weightList)
+{
+    if (tarCoordMatrix.rows() != srcCoordMatrix.rows() || weightList.size() != tarCoordMatrix.rows())
     {
-        U.col(2) = -U.col(2);
+        throw runtime_error((format("Size mismatch: %d tar, %d src, %d weight") %
+            tarCoordMatrix.rows() % srcCoordMatrix.rows() % weightList.size()).str());
+    }
+
+    double weightSum = weightList.sum();
+
+    if (!(weightSum > 0.))
+    {
+        throw runtime_error((format("Invalid weight sum: %f") % weightSum).str());
+    }
+
+    RowVector3d srcCenterCoord = weightList.transpose().lazyProduct(srcCoordMatrix) / weightSum;
+    RowVector3d tarCenterCoord = weightList.transpose().lazyProduct(tarCoordMatrix) / weightSum;
+
+    Matrix3d covMatrix = srcCoordMatrix.transpose().lazyProduct(weightList.asDiagonal() * tarCoordMatrix) -
+        weightSum * srcCenterCoord.transpose() * tarCenterCoord;
+
+    double tarInnerProduct = weightList.dot(tarCoordMatrix.rowwise().squaredNorm()) -
+        weightSum * tarCenterCoord.squaredNorm();
+
+    double srcInnerProduct = weightList.dot(srcCoordMatrix.rowwise().squaredNorm()) -
+        weightSum * srcCenterCoord.squaredNorm();
+
+    return {srcCenterCoord, tarCenterCoord, covMatrix, tarInnerProduct, srcInnerProduct};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Weighted Superimpose Rotation Matrix (Weighted Kabsch Algorithm)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+tuple<RowVector3d, Matrix3d, RowVector3d> calcWeightedSuperimposeRotationMatrix(
+    const Ref<const MatrixX3d> &tarCoordMatrix, const Ref<const MatrixX3d> &srcCoordMatrix,
+    const Ref<const VectorXd> &weightList)
+{
+    auto [srcCenterCoord, tarCenterCoord, covMatrix, tarInnerProduct, srcInnerProduct] =
+        __calcWeightedSuperimposeStatistics(tarCoordMatrix, srcCoordMatrix, weightList);
+
+    return {srcCenterCoord, __calcKabschRotationMatrix(covMatrix), tarCenterCoord};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Weighted RMSD After Weighted Superimpose A <= B
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double calcWeightedRMSDAfterSuperimpose(const Ref<const MatrixX3d> &tarCoordMatrix,
+    const Ref<const MatrixX3d> &srcCoordMatrix, const Ref<const VectorXd> &weightList)
+{
+    auto [srcCenterCoord, tarCenterCoord, covMatrix, tarInnerProduct, srcInnerProduct] =
+        __calcWeightedSuperimposeStatistics(tarCoordMatrix, srcCoordMatrix, weightList);
+
+    double squaredDeviation = tarInnerProduct + srcInnerProduct -
+        2. * __calcKabschRotationMatrix(covMatrix).cwiseProduct(covMatrix).sum();
+
+    return sqrt(max(squaredDeviation, 0.) / weightList.sum());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Iterative Superimpose Rotation Matrix (Refit On The Core Atoms Below deviationCutoff)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+tuple<RowVector3d, Matrix3d, RowVector3d, vector<int>> calcIterativeSuperimposeRotationMatrix(
+    const Ref<const MatrixX3d> &tarCoordMatrix, const Ref<const MatrixX3d> &srcCoordMatrix,
+    double deviationCutoff = 2., int maxIter = 10, int minCoreAtomNum = 3, const VectorXd &weightList = VectorXd())
+{
+    int atomNum = tarCoordMatrix.rows();
+
+    VectorXd atomWeightList = weightList.size() ? weightList : VectorXd::Ones(atomNum);
+
+    auto [srcOriginCoord, tarOriginCoord, crossSumMatrix, tarInnerProduct, srcInnerProduct] =
+        __calcWeightedSuperimposeStatistics(tarCoordMatrix, srcCoordMatrix, atomWeightList);
+
+    // Core Sums Relative To The Full-Set Centers
+    double weightSum = atomWeightList.sum();
+    RowVector3d srcSumCoord = RowVector3d::Zero(), tarSumCoord = RowVector3d::Zero();
+
+    auto fitFunc = [&]() -> tuple<RowVector3d, Matrix3d, RowVector3d>
+    {
+        RowVector3d srcMeanCoord = srcSumCoord / weightSum, tarMeanCoord = tarSumCoord / weightSum;
+
+        return {srcOriginCoord + srcMeanCoord,
+            __calcKabschRotationMatrix(crossSumMatrix - weightSum * srcMeanCoord.transpose() * tarMeanCoord),
+            tarOriginCoord + tarMeanCoord};
+    };
+
+    Array<bool, Dynamic, 1> coreBoolList = Array<bool, Dynamic, 1>::Constant(atomNum, true);
+
+    for (int iterIdx = 0; iterIdx < maxIter; iterIdx++)
+    {
+        auto [srcCenterCoord, rotationMatrix, tarCenterCoord] = fitFunc();
+
+        Array<bool, Dynamic, 1> newCoreBoolList = ((((srcCoordMatrix.rowwise() - srcCenterCoord) *
+            rotationMatrix).rowwise() + tarCenterCoord) - tarCoordMatrix).rowwise().squaredNorm().array() <
+            deviationCutoff * deviationCutoff;
+
+        if (newCoreBoolList.count() < max(minCoreAtomNum, 1) || (newCoreBoolList == coreBoolList).all())
+        {
+            break;
+        }
+
+        // Only The Atoms Entering Or Leaving The Core Update The Sums
+        for (int atomIdx = 0; atomIdx < atomNum; atomIdx++)
+        {
+            if (newCoreBoolList[atomIdx] != coreBoolList[atomIdx])
+            {
+                double atomWeight = newCoreBoolList[atomIdx] ? atomWeightList[atomIdx] : -atomWeightList[atomIdx];
+
+                RowVector3d srcCoord = srcCoordMatrix.row(atomIdx) - srcOriginCoord;
+                RowVector3d tarCoord = tarCoordMatrix.row(atomIdx) - tarOriginCoord;
+
+                weightSum += atomWeight;
+                srcSumCoord += atomWeight * srcCoord;
+                tarSumCoord += atomWeight * tarCoord;
+                crossSumMatrix += atomWeight * srcCoord.transpose() * tarCoord;
+            }
+        }
+
+        coreBoolList = newCoreBoolList;
+    }
+
+    auto [srcCenterCoord, rotationMatrix, tarCenterCoord] = fitFunc();
+
+    vector<int> coreIdxList;
+
+    for (int atomIdx = 0; atomIdx < atomNum; atomIdx++)
+    {
+        if (coreBoolList[atomIdx])
+        {
+            coreIdxList.push_back(atomIdx);
+        }
     }
 
-    auto rotationMatrix = U * V;
+    return {srcCenterCoord, rotationMatrix, tarCenterCoord, coreIdxList};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc QCP Max Eigenvalue (Theobald, Newton-Raphson On The Characteristic Polynomial)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double __calcQCPMaxEigenvalue(double tarInnerProduct, double srcInnerProduct, const Matrix3d &covMatrix)
+{
+    double Sxx = covMatrix(0, 0), Sxy = covMatrix(0, 1), Sxz = covMatrix(0, 2),
+           Syx = covMatrix(1, 0), Syy = covMatrix(1, 1), Syz = covMatrix(1, 2),
+           Szx = covMatrix(2, 0), Szy = covMatrix(2, 1), Szz = covMatrix(2, 2);
+
+    double Sxx2 = Sxx * Sxx, Syy2 = Syy * Syy, Szz2 = Szz * Szz,
+           Sxy2 = Sxy * Sxy, Syz2 = Syz * Syz, Sxz2 = Sxz * Sxz,
+           Syx2 = Syx * Syx, Szy2 = Szy * Szy, Szx2 = Szx * Szx;
+
+    double SyzSzymSyySzz2 = 2. * (Syz * Szy - Syy * Szz);
+    double Sxx2Syy2Szz2Syz2Szy2 = Syy2 + Szz2 - Sxx2 + Syz2 + Szy2;
+    double Sxy2Sxz2Syx2Szx2 = Sxy2 + Sxz2 - Syx2 - Szx2;
+
+    double SxzpSzx = Sxz + Szx, SyzpSzy = Syz + Szy, SxypSyx = Sxy + Syx,
+           SyzmSzy = Syz - Szy, SxzmSzx = Sxz - Szx, SxymSyx = Sxy - Syx,
+           SxxpSyy = Sxx + Syy, SxxmSyy = Sxx - Syy;
+
+    double C2 = -2. * (Sxx2 + Syy2 + Szz2 + Sxy2 + Syx2 + Sxz2 + Szx2 + Syz2 + Szy2);
+
+    double C1 = 8. * (Sxx * Syz * Szy + Syy * Szx * Sxz + Szz * Sxy * Syx -
+        Sxx * Syy * Szz - Syz * Szx * Sxy - Szy * Syx * Sxz);
+
+    double C0 = Sxy2Sxz2Syx2Szx2 * Sxy2Sxz2Syx2Szx2 +
+        (Sxx2Syy2Szz2Syz2Szy2 + SyzSzymSyySzz2) * (Sxx2Syy2Szz2Syz2Szy2 - SyzSzymSyySzz2) +
+        (-SxzpSzx * SyzmSzy + SxymSyx * (SxxmSyy - Szz)) * (-SxzmSzx * SyzpSzy + SxymSyx * (SxxmSyy + Szz)) +
+        (-SxzpSzx * SyzpSzy - SxypSyx * (SxxpSyy - Szz)) * (-SxzmSzx * SyzmSzy - SxypSyx * (SxxpSyy + Szz)) +
+        (SxypSyx * SyzpSzy + SxzpSzx * (SxxmSyy + Szz)) * (-SxymSyx * SyzmSzy + SxzpSzx * (SxxpSyy + Szz)) +
+        (SxypSyx * SyzmSzy + SxzmSzx * (SxxmSyy - Szz)) * (-SxymSyx * SyzpSzy + SxzmSzx * (SxxpSyy - Szz));
+
+    double maxEigenvalue = (tarInnerProduct + srcInnerProduct) / 2.;
+
+    for (int iterIdx = 0; iterIdx < 50; iterIdx++)
+    {
+        double lastEigenvalue = maxEigenvalue;
+        double x2 = maxEigenvalue * maxEigenvalue;
+        double b  = (x2 + C2) * maxEigenvalue;
+        double a  = b + C1;
+
+        maxEigenvalue -= (a * maxEigenvalue + C0) / (2. * x2 * maxEigenvalue + b + a);
+
+        if (fabs(maxEigenvalue - lastEigenvalue) < fabs(1e-11 * maxEigenvalue))
+        {
+            break;
+        }
+    }
+
+    return maxEigenvalue;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc QCP Rotation Matrix (Liu, Quaternion From The Adjugate Of The Key Matrix)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Matrix3d __calcQCPRotationMatrix(const Matrix3d &covMatrix, double maxEigenvalue)
+{
+    double Sxx = covMatrix(0, 0), Sxy = covMatrix(0, 1), Sxz = covMatrix(0, 2),
+           Syx = covMatrix(1, 0), Syy = covMatrix(1, 1), Syz = covMatrix(1, 2),
+           Szx = covMatrix(2, 0), Szy = covMatrix(2, 1), Szz = covMatrix(2, 2);
+
+    double a11 = Sxx + Syy + Szz - maxEigenvalue, a12 = Syz - Szy, a13 = Szx - Sxz, a14 = Sxy - Syx,
+           a21 = a12, a22 = Sxx - Syy - Szz - maxEigenvalue, a23 = Sxy + Syx, a24 = Sxz + Szx,
+           a31 = a13, a32 = a23, a33 = Syy - Sxx - Szz - maxEigenvalue, a34 = Syz + Szy,
+           a41 = a14, a42 = a24, a43 = a34, a44 = Szz - Sxx - Syy - maxEigenvalue;
+
+    double a3344_4334 = a33 * a44 - a43 * a34, a3244_4234 = a32 * a44 - a42 * a34,
+           a3243_4233 = a32 * a43 - a42 * a33, a3143_4133 = a31 * a43 - a41 * a33,
+           a3144_4134 = a31 * a44 - a41 * a34, a3142_4132 = a31 * a42 - a41 * a32;
+
+    double q1 =  a22 * a3344_4334 - a23 * a3244_4234 + a24 * a3243_4233;
+    double q2 = -a21 * a3344_4334 + a23 * a3144_4134 - a24 * a3143_4133;
+    double q3 =  a21 * a3244_4234 - a22 * a3144_4134 + a24 * a3142_4132;
+    double q4 = -a21 * a3243_4233 + a22 * a3143_4133 - a23 * a3142_4132;
+
+    double qSquaredNorm = q1 * q1 + q2 * q2 + q3 * q3 + q4 * q4;
+
+    // Degenerate Columns Of The Adjugate: Try The Other Ones
+    if (qSquaredNorm < 1e-6)
+    {
+        q1 =  a12 * a3344_4334 - a13 * a3244_4234 + a14 * a3243_4233;
+        q2 = -a11 * a3344_4334 + a13 * a3144_4134 - a14 * a3143_4133;
+        q3 =  a11 * a3244_4234 - a12 * a3144_4134 + a14 * a3142_4132;
+        q4 = -a11 * a3243_4233 + a12 * a3143_4133 - a13 * a3142_4132;
+
+        qSquaredNorm = q1 * q1 + q2 * q2 + q3 * q3 + q4 * q4;
+    }
+
+    if (qSquaredNorm < 1e-6)
+    {
+        double a1324_1423 = a13 * a24 - a14 * a23, a1224_1422 = a12 * a24 - a14 * a22,
+               a1223_1322 = a12 * a23 - a13 * a22, a1124_1421 = a11 * a24 - a14 * a21,
+               a1123_1321 = a11 * a23 - a13 * a21, a1122_1221 = a11 * a22 - a12 * a21;
+
+        q1 =  a42 * a1324_1423 - a43 * a1224_1422 + a44 * a1223_1322;
+        q2 = -a41 * a1324_1423 + a43 * a1124_1421 - a44 * a1123_1321;
+        q3 =  a41 * a1224_1422 - a42 * a1124_1421 + a44 * a1122_1221;
+        q4 = -a41 * a1223_1322 + a42 * a1123_1321 - a43 * a1122_1221;
+
+        qSquaredNorm = q1 * q1 + q2 * q2 + q3 * q3 + q4 * q4;
+
+        if (qSquaredNorm < 1e-6)
+        {
+            q1 =  a32 * a1324_1423 - a33 * a1224_1422 + a34 * a1223_1322;
+            q2 = -a31 * a1324_1423 + a33 * a1124_1421 - a34 * a1123_1321;
+            q3 =  a31 * a1224_1422 - a32 * a1124_1421 + a34 * a1122_1221;
+            q4 = -a31 * a1223_1322 + a32 * a1123_1321 - a33 * a1122_1221;
+
+            qSquaredNorm = q1 * q1 + q2 * q2 + q3 * q3 + q4 * q4;
+        }
+    }
+
+    // Already Superimposed
+    if (qSquaredNorm < 1e-6)
+    {
+        return Matrix3d::Identity();
+    }
+
+    double qNorm = sqrt(qSquaredNorm);
+
+    q1 /= qNorm;
+    q2 /= qNorm;
+    q3 /= qNorm;
+    q4 /= qNorm;
+
+    double a2 = q1 * q1, x2 = q2 * q2, y2 = q3 * q3, z2 = q4 * q4,
+           xy = q2 * q3, az = q1 * q4, zx = q4 * q2, ay = q1 * q3, yz = q3 * q4, ax = q1 * q2;
+
+    return (Matrix3d() <<
+        a2 + x2 - y2 - z2, 2. * (xy + az), 2. * (zx - ay),
+        2. * (xy - az), a2 - x2 + y2 - z2, 2. * (yz + ax),
+        2. * (zx + ay), 2. * (yz - ax), a2 - x2 - y2 + z2).finished();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc RMSD By QCP (Precomputed Inner Products And Covariance)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double calcRMSDByQCP(double tarInnerProduct, double srcInnerProduct, const Matrix3d &covMatrix, int atomNum)
+{
+    double maxEigenvalue = __calcQCPMaxEigenvalue(tarInnerProduct, srcInnerProduct, covMatrix);
+
+    return sqrt(fabs(tarInnerProduct + srcInnerProduct - 2. * maxEigenvalue) / atomNum);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Superimpose Rotation Matrix By QCP
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+tuple<RowVector3d, Matrix3d, RowVector3d> calcSuperimposeRotationMatrixByQCP(
+    const Ref<const MatrixX3d> &tarCoordMatrix, const Ref<const MatrixX3d> &srcCoordMatrix)
+{
+    auto [srcCenterCoord, tarCenterCoord, covMatrix, tarInnerProduct, srcInnerProduct] =
+        __calcSuperimposeStatistics(tarCoordMatrix, srcCoordMatrix);
+
+    Matrix3d rotationMatrix = __calcQCPRotationMatrix(covMatrix,
+        __calcQCPMaxEigenvalue(tarInnerProduct, srcInnerProduct, covMatrix));
 
     return {srcCenterCoord, rotationMatrix, tarCenterCoord};
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Calc RMSD After Superimpose A <= B
+// Calc RMSD After Superimpose By QCP A <= B
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-double calcRMSDAfterSuperimpose(const MatrixX3d &tarCoordMatrix, const MatrixX3d &srcCoordMatrix)
+double calcRMSDAfterSuperimposeByQCP(const Ref<const MatrixX3d> &tarCoordMatrix,
+    const Ref<const MatrixX3d> &srcCoordMatrix)
 {
-    auto [srcCenterCoord, rotationMatrix, tarCenterCoord] = calcSuperimposeRotationMatrix(tarCoordMatrix, srcCoordMatrix);
+    auto [srcCenterCoord, tarCenterCoord, covMatrix, tarInnerProduct, srcInnerProduct] =
+        __calcSuperimposeStatistics(tarCoordMatrix, srcCoordMatrix);
 
-    return calcRMSD(tarCoordMatrix, (((srcCoordMatrix.rowwise() - srcCenterCoord) * rotationMatrix).rowwise() + tarCenterCoord).eval());
+    return calcRMSDByQCP(tarInnerProduct, srcInnerProduct, covMatrix, tarCoordMatrix.rows());
 }
 
 
@@ -0,0 +1,88 @@
+/*
+    ModelReader.h
+    =============
+        Class ModelReader header.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <Eigen/Dense>
+#include "Predecl.h"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::ifstream;
+using std::ostream;
+using Eigen::MatrixX3d;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Class ModelReader
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ModelReader
+{
+    // Friend
+    friend ostream &operator<<(ostream &os, const ModelReader &modelReaderObj);
+
+
+public:
+
+    // Constructor
+    explicit ModelReader(const string &pdbFilePath, bool parseHBool = false);
+
+
+    // Getter: __pdbFilePath
+    const string &pdbFilePath() const;
+
+
+    // Getter: __modelNum (Number Of Models Read So Far)
+    int modelNum() const;
+
+
+    // Next Model
+    Protein *nextModel();
+
+
+    // Next Model Coord
+    bool nextCoord(MatrixX3d &coordMatrix);
+
+
+private:
+
+    // Data
+    string __pdbFilePath;
+    ifstream __f;
+    string __line;
+    bool __parseHBool;
+    int __modelNum;
+    int __atomNum;
+    int __pendingModelSerial;
+    vector<double> __coordList;
+
+
+    // Next Line Of The Current Model (ATOM Lines Only)
+    bool __nextAtomLine(int &modelSerial, bool &startBool);
+
+
+    // Check Atom Num
+    void __checkAtomNum(int atomNum);
+
+
+    // str
+    string __str() const;
+};
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,293 @@
+/*
+    ModelReader.hpp
+    ===============
+        Class ModelReader implementation.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <charconv>
+#include <system_error>
+#include <stdexcept>
+#include <boost/format.hpp>
+#include <boost/algorithm/string.hpp>
+#include <Eigen/Dense>
+#include "ModelReader.h"
+#include "Protein.h"
+#include "Parser.hpp"
+#include "Util.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::getline;
+using std::stoi;
+using std::from_chars;
+using std::errc;
+using std::filesystem::path;
+using std::runtime_error;
+using boost::format;
+using boost::algorithm::trim;
+using Eigen::MatrixX3d;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Parse Coord Field (8 Columns, Without Building A Substring)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double __parseCoordField(const string &line, int startIdx)
+{
+    const char *firstPtr = line.data() + startIdx, *lastPtr = firstPtr + 8;
+
+    while (firstPtr < lastPtr && *firstPtr == ' ')
+    {
+        firstPtr++;
+    }
+
+    double coordValue;
+
+    if (from_chars(firstPtr, lastPtr, coordValue).ec != errc())
+    {
+        throw runtime_error((format("Invalid coord: %s") % line).str());
+    }
+
+    return coordValue;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ModelReader::ModelReader(const string &pdbFilePath, bool parseHBool):
+    __pdbFilePath(pdbFilePath),
+    __f(pdbFilePath),
+    __parseHBool(parseHBool),
+    __modelNum(0),
+    __atomNum(-1),
+    __pendingModelSerial(0)
+{
+    if (!__f)
+    {
+        throw runtime_error(pdbFilePath + " not exists");
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __pdbFilePath
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const string &ModelReader::pdbFilePath() const
+{
+    return __pdbFilePath;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __modelNum
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int ModelReader::modelNum() const
+{
+    return __modelNum;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Next Model (nullptr At The End Of The File)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Protein *ModelReader::nextModel()
+{
+    int modelSerial = __pendingModelSerial, atomNum = 0;
+    bool startBool = false;
+    __PDBParseState stateObj(nullptr);
+
+    __pendingModelSerial = 0;
+
+    while (__nextAtomLine(modelSerial, startBool))
+    {
+        if (!stateObj.proPtr)
+        {
+            stateObj.proPtr = new Protein(path(__pdbFilePath).stem().string(), modelSerial);
+        }
+
+        // H Atoms Are Already Filtered By __nextAtomLine
+        __parseAtomLine(__line, stateObj, true);
+
+        atomNum++;
+    }
+
+    if (stateObj.proPtr)
+    {
+        __modelNum++;
+        __atomNum = atomNum;
+    }
+
+    return stateObj.proPtr;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Next Model Coord (false At The End Of The File)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ModelReader::nextCoord(MatrixX3d &coordMatrix)
+{
+    int modelSerial = __pendingModelSerial, atomNum = 0;
+    bool startBool = false;
+
+    __pendingModelSerial = 0;
+
+    // Atom Number Known: Parse Straight Into coordMatrix, Which Is Only Resized On The First Call
+    if (__atomNum >= 0)
+    {
+        if (coordMatrix.rows() != __atomNum)
+        {
+            coordMatrix.resize(__atomNum, 3);
+        }
+
+        while (__nextAtomLine(modelSerial, startBool))
+        {
+            if (atomNum < __atomNum)
+            {
+                coordMatrix(atomNum, 0) = __parseCoordField(__line, 30);
+                coordMatrix(atomNum, 1) = __parseCoordField(__line, 38);
+                coordMatrix(atomNum, 2) = __parseCoordField(__line, 46);
+            }
+
+            atomNum++;
+        }
+
+        if (!startBool)
+        {
+            return false;
+        }
+
+        __checkAtomNum(atomNum);
+    }
+    else
+    {
+        __coordList.clear();
+
+        while (__nextAtomLine(modelSerial, startBool))
+        {
+            __coordList.push_back(__parseCoordField(__line, 30));
+            __coordList.push_back(__parseCoordField(__line, 38));
+            __coordList.push_back(__parseCoordField(__line, 46));
+        }
+
+        if (!startBool)
+        {
+            return false;
+        }
+
+        __atomNum = __coordList.size() / 3;
+
+        coordMatrix.resize(__atomNum, 3);
+
+        for (int atomIdx = 0; atomIdx < __atomNum; atomIdx++)
+        {
+            coordMatrix.row(atomIdx) << __coordList[atomIdx * 3], __coordList[atomIdx * 3 + 1],
+                __coordList[atomIdx * 3 + 2];
+        }
+    }
+
+    __modelNum++;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Next Line Of The Current Model (ATOM Lines Only)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ModelReader::__nextAtomLine(int &modelSerial, bool &startBool)
+{
+    while (getline(__f, __line))
+    {
+        if (__line.compare(0, 5, "MODEL") == 0)
+        {
+            // Missing ENDMDL: This MODEL Record Starts The Next Model
+            if (startBool)
+            {
+                __pendingModelSerial = stoi(__line.substr(10, 4));
+
+                return false;
+            }
+
+            modelSerial = stoi(__line.substr(10, 4));
+        }
+        else if (__line.compare(0, 6, "ENDMDL") == 0)
+        {
+            if (startBool)
+            {
+                return false;
+            }
+        }
+        else if (__line.compare(0, 4, "ATOM") == 0)
+        {
+            if (__line.size() < 54)
+            {
+                throw runtime_error((format("Invalid ATOM line: %s") % __line).str());
+            }
+
+            if (!__parseHBool)
+            {
+                string atomName = __line.substr(12, 4);
+
+                trim(atomName);
+
+                if (isH(atomName))
+                {
+                    continue;
+                }
+            }
+
+            startBool = true;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Check Atom Num
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ModelReader::__checkAtomNum(int atomNum)
+{
+    if (atomNum != __atomNum)
+    {
+        throw runtime_error((format("Atom number mismatch in model %d: %d vs %d") %
+            (__modelNum + 1) % atomNum % __atomNum).str());
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// str
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string ModelReader::__str() const
+{
+    return (format("<ModelReader object: %s, %d models read, at %p>") % __pdbFilePath % __modelNum % this).str();
+}
+
+
+}  // End namespace PDBTools
@@ -25,7 +25,10 @@ using std::vector;
 using std::unordered_set;
 using std::initializer_list;
 using Eigen::RowVector3d;
+using Eigen::Matrix3d;
 using Eigen::MatrixX3d;
+using Eigen::MatrixX4d;
+using Eigen::Ref;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -49,6 +52,10 @@ public:
     vector<Atom *> filterAtoms(const unordered_set<string> &atomNameSet = {"CA"});
 
 
+    // Select Atoms
+    vector<Atom *> selectAtoms(const string &selStr);
+
+
     // Get Atoms Coord
     MatrixX3d getAtomsCoord();
 
@@ -57,6 +64,19 @@ public:
     MatrixX3d filterAtomsCoord(const unordered_set<string> &atomNameSet = {"CA"});
 
 
+    // Get Atoms Coord (Buffer)
+    SelfType *getAtomsCoord(Ref<MatrixX3d> coordMatrix);
+
+
+    // Filter Atoms Coord (Buffer)
+    SelfType *filterAtomsCoord(Ref<MatrixX3d> coordMatrix, vector<int> &atomIdxList,
+        const unordered_set<string> &atomNameSet = {"CA"});
+
+
+    // Gather Atoms Coord
+    SelfType *gatherAtomsCoord(const vector<int> &atomIdxList, Ref<MatrixX3d> coordMatrix);
+
+
     // Center
     RowVector3d center();
 
@@ -65,6 +85,31 @@ public:
     SelfType *moveCenter();
 
 
+    // Transform
+    SelfType *transform(const Matrix3d &rotationMatrix, const RowVector3d &translationVector);
+
+
+    // Superimpose Onto
+    SelfType *superimposeOnto(const MatrixX3d &tarCoordMatrix, const unordered_set<string> &atomNameSet = {"CA"});
+
+
+    // Superimpose Onto (Object)
+    template <typename TarType>
+    SelfType *superimposeOnto(TarType *tarPtr, const unordered_set<string> &atomNameSet = {"CA"});
+
+
+    // Calc Backbone Dihedral Angle Matrix
+    MatrixX3d calcBBDihedralAngleMatrix();
+
+
+    // Calc Side Chain Dihedral Angle Matrix
+    MatrixX4d calcSCDihedralAngleMatrix();
+
+
+    // Calc Secondary Structure
+    string calcSecondaryStructure();
+
+
     // Seq
     string seq();
 
@@ -12,10 +12,16 @@
 #include <cstdio>
 #include <iterator>
 #include <initializer_list>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
 #include <boost/format.hpp>
 #include <Eigen/Dense>
 #include "NotAtom.h"
 #include "Predecl.h"
+#include "Math.hpp"
+#include "DSSP.hpp"
+#include "Selection.hpp"
 #include "Constants.hpp"
 
 namespace PDBTools
@@ -30,9 +36,20 @@ using std::vector;
 using std::unordered_set;
 using std::distance;
 using std::initializer_list;
+using std::runtime_error;
+using std::is_same_v;
+using std::remove_pointer_t;
 using boost::format;
 using Eigen::RowVector3d;
+using Eigen::Matrix3d;
+using Eigen::VectorXd;
 using Eigen::MatrixX3d;
+using Eigen::MatrixX4d;
+using Eigen::Ref;
+using Eigen::Matrix;
+using Eigen::Map;
+using Eigen::Dynamic;
+using Eigen::RowMajor;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -78,6 +95,17 @@ vector<Atom *> __NotAtom<SelfType, SubType>::filterAtoms(const unordered_set<str
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Select Atoms
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename SelfType, typename SubType>
+vector<Atom *> __NotAtom<SelfType, SubType>::selectAtoms(const string &selStr)
+{
+    return Selection(selStr).select(static_cast<SelfType *>(this)->getAtoms());
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Get Atoms Coord
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -105,19 +133,147 @@ MatrixX3d __NotAtom<SelfType, SubType>::getAtomsCoord()
 template <typename SelfType, typename SubType>
 MatrixX3d __NotAtom<SelfType, SubType>::filterAtomsCoord(const unordered_set<string> &atomNameSet)
 {
-    auto atomPtrList = static_cast<SelfType *>(this)->filterAtoms();
+    auto atomPtrList = static_cast<SelfType *>(this)->filterAtoms(atomNameSet);
 
     MatrixX3d coordMatrix(atomPtrList.size(), 3);
 
     for (int idx = 0; idx < atomPtrList.size(); idx++)
     {
-        if (atomNameSet.count(atomPtrList[idx]->name()))
+        coordMatrix.row(idx) = atomPtrList[idx]->coord();
+    }
+
+    return coordMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// For Each Atom (Without Building An Atom List)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename NotAtomType, typename Func>
+void __forEachAtom(NotAtomType *notAtomPtr, Func &func)
+{
+    for (auto subPtr: notAtomPtr->sub())
+    {
+        if constexpr (is_same_v<remove_pointer_t<decltype(subPtr)>, Atom>)
+        {
+            func(subPtr);
+        }
+        else
         {
-            coordMatrix.row(idx) = atomPtrList[idx]->coord();
+            __forEachAtom(subPtr, func);
         }
     }
+}
 
-    return coordMatrix;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Check Coord Buffer Size
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void __checkCoordBufferSize(int rowNum, int atomNum)
+{
+    if (rowNum < atomNum)
+    {
+        throw runtime_error((format("Coord buffer too small: %d rows for %d atoms") % rowNum % atomNum).str());
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Atoms Coord (Buffer)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename SelfType, typename SubType>
+SelfType *__NotAtom<SelfType, SubType>::getAtomsCoord(Ref<MatrixX3d> coordMatrix)
+{
+    int atomNum = 0;
+
+    auto gatherFunc = [&](Atom *atomPtr)
+    {
+        if (atomNum < coordMatrix.rows())
+        {
+            coordMatrix.row(atomNum) = atomPtr->coord();
+        }
+
+        atomNum++;
+    };
+
+    __forEachAtom(static_cast<SelfType *>(this), gatherFunc);
+
+    __checkCoordBufferSize(coordMatrix.rows(), atomNum);
+
+    return static_cast<SelfType *>(this);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Filter Atoms Coord (Buffer)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename SelfType, typename SubType>
+SelfType *__NotAtom<SelfType, SubType>::filterAtomsCoord(Ref<MatrixX3d> coordMatrix, vector<int> &atomIdxList,
+    const unordered_set<string> &atomNameSet)
+{
+    int atomIdx = 0;
+
+    atomIdxList.clear();
+
+    auto gatherFunc = [&](Atom *atomPtr)
+    {
+        if (atomNameSet.count(atomPtr->name()))
+        {
+            if ((int) atomIdxList.size() < coordMatrix.rows())
+            {
+                coordMatrix.row(atomIdxList.size()) = atomPtr->coord();
+            }
+
+            atomIdxList.push_back(atomIdx);
+        }
+
+        atomIdx++;
+    };
+
+    __forEachAtom(static_cast<SelfType *>(this), gatherFunc);
+
+    __checkCoordBufferSize(coordMatrix.rows(), atomIdxList.size());
+
+    return static_cast<SelfType *>(this);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Gather Atoms Coord (atomIdxList Must Be Ascending, e.g. From filterAtomsCoord)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename SelfType, typename SubType>
+SelfType *__NotAtom<SelfType, SubType>::gatherAtomsCoord(const vector<int> &atomIdxList,
+    Ref<MatrixX3d> coordMatrix)
+{
+    __checkCoordBufferSize(coordMatrix.rows(), atomIdxList.size());
+
+    int atomIdx = 0, rowIdx = 0;
+
+    auto gatherFunc = [&](Atom *atomPtr)
+    {
+        if (rowIdx < (int) atomIdxList.size() && atomIdxList[rowIdx] == atomIdx)
+        {
+            coordMatrix.row(rowIdx) = atomPtr->coord();
+            rowIdx++;
+        }
+
+        atomIdx++;
+    };
+
+    __forEachAtom(static_cast<SelfType *>(this), gatherFunc);
+
+    if (rowIdx != (int) atomIdxList.size())
+    {
+        throw runtime_error((format("Invalid atom index: %d (atom number: %d, indices must be ascending)") %
+            atomIdxList[rowIdx] % atomIdx).str());
+    }
+
+    return static_cast<SelfType *>(this);
 }
 
 
@@ -150,6 +306,205 @@ SelfType *__NotAtom<SelfType, SubType>::moveCenter()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Transform (coord * rotationMatrix + translationVector)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename SelfType, typename SubType>
+SelfType *__NotAtom<SelfType, SubType>::transform(const Matrix3d &rotationMatrix,
+    const RowVector3d &translationVector)
+{
+    auto atomPtrList = static_cast<SelfType *>(this)->getAtoms();
+
+    MatrixX3d coordMatrix(atomPtrList.size(), 3);
+
+    for (int idx = 0; idx < (int) atomPtrList.size(); idx++)
+    {
+        coordMatrix.row(idx) = atomPtrList[idx]->coord();
+    }
+
+    // One Product Over The Gathered Coords, Then Scatter Back
+    MatrixX3d newCoordMatrix = (coordMatrix * rotationMatrix).rowwise() + translationVector;
+
+    for (int idx = 0; idx < (int) atomPtrList.size(); idx++)
+    {
+        atomPtrList[idx]->coord() = newCoordMatrix.row(idx);
+    }
+
+    return static_cast<SelfType *>(this);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Superimpose Onto
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename SelfType, typename SubType>
+SelfType *__NotAtom<SelfType, SubType>::superimposeOnto(const MatrixX3d &tarCoordMatrix,
+    const unordered_set<string> &atomNameSet)
+{
+    auto atomPtrList = filterAtoms(atomNameSet);
+
+    if ((int) atomPtrList.size() != tarCoordMatrix.rows())
+    {
+        throw runtime_error((format("Atom number mismatch: %d selected vs %d target") %
+            atomPtrList.size() % tarCoordMatrix.rows()).str());
+    }
+
+    MatrixX3d srcCoordMatrix(atomPtrList.size(), 3);
+
+    for (int idx = 0; idx < (int) atomPtrList.size(); idx++)
+    {
+        srcCoordMatrix.row(idx) = atomPtrList[idx]->coord();
+    }
+
+    auto [srcCenterCoord, rotationMatrix, tarCenterCoord] = calcSuperimposeRotationMatrix(
+        tarCoordMatrix, srcCoordMatrix);
+
+    return transform(rotationMatrix, tarCenterCoord - srcCenterCoord * rotationMatrix);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Superimpose Onto (Object)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename SelfType, typename SubType>
+template <typename TarType>
+SelfType *__NotAtom<SelfType, SubType>::superimposeOnto(TarType *tarPtr, const unordered_set<string> &atomNameSet)
+{
+    auto atomPtrList = tarPtr->filterAtoms(atomNameSet);
+
+    MatrixX3d tarCoordMatrix(atomPtrList.size(), 3);
+
+    for (int idx = 0; idx < (int) atomPtrList.size(); idx++)
+    {
+        tarCoordMatrix.row(idx) = atomPtrList[idx]->coord();
+    }
+
+    return superimposeOnto(tarCoordMatrix, atomNameSet);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Backbone Dihedral Angle Matrix (Phi, Psi, Omega)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename SelfType, typename SubType>
+MatrixX3d __NotAtom<SelfType, SubType>::calcBBDihedralAngleMatrix()
+{
+    auto resPtrList = static_cast<SelfType *>(this)->getResidues();
+    int resNum = resPtrList.size();
+
+    // Backbone Trace: N, CA, C, N, CA, C, ...
+    MatrixX3d bbCoordMatrix = MatrixX3d::Constant(resNum * 3, 3, NAN);
+    MatrixX3d dihedralAngleMatrix = MatrixX3d::Constant(resNum, 3, NAN);
+
+    for (int resIdx = 0; resIdx < resNum; resIdx++)
+    {
+        for (auto atomPtr: *resPtrList[resIdx])
+        {
+            if (atomPtr->name() == "N")
+            {
+                bbCoordMatrix.row(resIdx * 3) = atomPtr->coord();
+            }
+            else if (atomPtr->name() == "CA")
+            {
+                bbCoordMatrix.row(resIdx * 3 + 1) = atomPtr->coord();
+            }
+            else if (atomPtr->name() == "C")
+            {
+                bbCoordMatrix.row(resIdx * 3 + 2) = atomPtr->coord();
+            }
+        }
+    }
+
+    if (resNum < 2)
+    {
+        return dihedralAngleMatrix;
+    }
+
+    int dihedralNum = resNum * 3 - 3;
+
+    VectorXd dihedralAngleList = calcRowwiseDihedralAngle(
+        bbCoordMatrix.topRows(dihedralNum),
+        bbCoordMatrix.middleRows(1, dihedralNum),
+        bbCoordMatrix.middleRows(2, dihedralNum),
+        bbCoordMatrix.bottomRows(dihedralNum));
+
+    for (int resIdx = 0; resIdx < resNum - 1; resIdx++)
+    {
+        if (resPtrList[resIdx]->owner() == resPtrList[resIdx + 1]->owner())
+        {
+            dihedralAngleMatrix(resIdx, 1)     = dihedralAngleList[resIdx * 3];
+            dihedralAngleMatrix(resIdx, 2)     = dihedralAngleList[resIdx * 3 + 1];
+            dihedralAngleMatrix(resIdx + 1, 0) = dihedralAngleList[resIdx * 3 + 2];
+        }
+    }
+
+    return dihedralAngleMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Side Chain Dihedral Angle Matrix (Chi1 ~ Chi4)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename SelfType, typename SubType>
+MatrixX4d __NotAtom<SelfType, SubType>::calcSCDihedralAngleMatrix()
+{
+    auto resPtrList = static_cast<SelfType *>(this)->getResidues();
+    int resNum = resPtrList.size();
+
+    MatrixX3d coordMatrixA = MatrixX3d::Constant(resNum * 4, 3, NAN);
+    MatrixX3d coordMatrixB = MatrixX3d::Constant(resNum * 4, 3, NAN);
+    MatrixX3d coordMatrixC = MatrixX3d::Constant(resNum * 4, 3, NAN);
+    MatrixX3d coordMatrixD = MatrixX3d::Constant(resNum * 4, 3, NAN);
+
+    MatrixX3d *coordMatrixPtrList[] = {&coordMatrixA, &coordMatrixB, &coordMatrixC, &coordMatrixD};
+
+    for (int resIdx = 0; resIdx < resNum; resIdx++)
+    {
+        auto atomNameListIter = __RESIDUE_SIDE_CHAIN_ROTATION_ATOMS_NAME_MAP.find(resPtrList[resIdx]->name());
+
+        if (atomNameListIter == __RESIDUE_SIDE_CHAIN_ROTATION_ATOMS_NAME_MAP.end())
+        {
+            continue;
+        }
+
+        for (int dihedralIdx = 0; dihedralIdx < (int) atomNameListIter->second.size() && dihedralIdx < 4; dihedralIdx++)
+        {
+            for (int atomIdx = 0; atomIdx < 4; atomIdx++)
+            {
+                for (auto atomPtr: *resPtrList[resIdx])
+                {
+                    if (atomPtr->name() == atomNameListIter->second[dihedralIdx][atomIdx])
+                    {
+                        coordMatrixPtrList[atomIdx]->row(resIdx * 4 + dihedralIdx) = atomPtr->coord();
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    VectorXd dihedralAngleList = calcRowwiseDihedralAngle(coordMatrixA, coordMatrixB, coordMatrixC, coordMatrixD);
+
+    return Map<Matrix<double, Dynamic, 4, RowMajor>>(dihedralAngleList.data(), resNum, 4);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Secondary Structure
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename SelfType, typename SubType>
+string __NotAtom<SelfType, SubType>::calcSecondaryStructure()
+{
+    return PDBTools::calcSecondaryStructure(static_cast<SelfType *>(this)->getResidues());
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Seq
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,94 @@
+/*
+    PCA.h
+    =====
+        Class PCA header.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <Eigen/Dense>
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::ostream;
+using Eigen::MatrixX3d;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+using Eigen::Ref;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Class PCA
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class PCA
+{
+    // Friend
+    friend ostream &operator<<(ostream &os, const PCA &pcaObj);
+
+
+public:
+
+    // Constructor
+    explicit PCA(const vector<MatrixX3d> &coordMatrixList, int modeNum = 10, int alignIterNum = 3);
+
+
+    // Getter: __meanCoordMatrix
+    const MatrixX3d &meanCoordMatrix() const;
+
+
+    // Getter: __eigenvalueList
+    const VectorXd &eigenvalueList() const;
+
+
+    // Getter: __modeMatrix
+    const MatrixXd &modeMatrix() const;
+
+
+    // Getter: __totalVariance
+    double totalVariance() const;
+
+
+    // Getter: __projectionMatrix
+    const MatrixXd &projectionMatrix() const;
+
+
+    // Project
+    VectorXd project(const Ref<const MatrixX3d> &coordMatrix) const;
+
+
+    // Reconstruct
+    MatrixX3d reconstruct(const Ref<const VectorXd> &projectionList) const;
+
+
+    // Calc Mode Coord
+    MatrixX3d calcModeCoord(int modeIdx, double projection) const;
+
+
+private:
+
+    // Data
+    MatrixX3d __refCoordMatrix;
+    MatrixX3d __meanCoordMatrix;
+    VectorXd __eigenvalueList;
+    MatrixXd __modeMatrix;
+    double __totalVariance;
+    MatrixXd __projectionMatrix;
+
+
+    // str
+    string __str() const;
+};
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,324 @@
+/*
+    PCA.hpp
+    =======
+        Class PCA implementation.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <boost/format.hpp>
+#include <Eigen/Dense>
+#include "PCA.h"
+#include "Math.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::pair;
+using std::min;
+using std::max;
+using std::runtime_error;
+using boost::format;
+using Eigen::RowVectorXd;
+using Eigen::MatrixX3d;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+using Eigen::Matrix;
+using Eigen::Map;
+using Eigen::Dynamic;
+using Eigen::RowMajor;
+using Eigen::SelfAdjointEigenSolver;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// PCA Eigensolver Parameters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Above This (min(Model Number, 3 * Atom Number)) The Randomized Eigensolver Is Used
+const int __PCA_EXACT_MAX_DIM = 2000;
+
+const int __PCA_OVERSAMPLE_NUM = 10;
+const int __PCA_POWER_ITER_NUM = 4;
+const unsigned __PCA_RANDOM_SEED = 0;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Top Right Singular Pairs (Squared Singular Values And Right Singular Vectors, Via The Smaller Gram Matrix)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename MatrixType>
+pair<VectorXd, MatrixXd> __calcTopRightSingularPairs(const MatrixType &dataMatrix, int modeNum)
+{
+    int rowNum = dataMatrix.rows(), colNum = dataMatrix.cols();
+
+    modeNum = min(modeNum, min(rowNum, colNum));
+
+    VectorXd squaredSingularValueList;
+    MatrixXd rightSingularMatrix;
+
+    if (colNum <= rowNum)
+    {
+        SelfAdjointEigenSolver<MatrixXd> eigenSolver(dataMatrix.transpose() * dataMatrix);
+
+        squaredSingularValueList = eigenSolver.eigenvalues().tail(modeNum).reverse();
+        rightSingularMatrix      = eigenSolver.eigenvectors().rightCols(modeNum).rowwise().reverse();
+    }
+    else
+    {
+        SelfAdjointEigenSolver<MatrixXd> eigenSolver(dataMatrix * dataMatrix.transpose());
+
+        squaredSingularValueList = eigenSolver.eigenvalues().tail(modeNum).reverse();
+        rightSingularMatrix      = dataMatrix.transpose() *
+            eigenSolver.eigenvectors().rightCols(modeNum).rowwise().reverse();
+
+        for (int modeIdx = 0; modeIdx < modeNum; modeIdx++)
+        {
+            double colNorm = rightSingularMatrix.col(modeIdx).norm();
+
+            if (colNorm > 0.)
+            {
+                rightSingularMatrix.col(modeIdx) /= colNorm;
+            }
+        }
+    }
+
+    squaredSingularValueList = squaredSingularValueList.cwiseMax(0.);
+
+    return {squaredSingularValueList, rightSingularMatrix};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Randomized Top Right Singular Pairs (Halko-Martinsson-Tropp Range Finder With Power Iterations)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename MatrixType>
+pair<VectorXd, MatrixXd> __calcRandomizedTopRightSingularPairs(const MatrixType &dataMatrix, int modeNum)
+{
+    int sampleNum = min(modeNum + __PCA_OVERSAMPLE_NUM, (int) min(dataMatrix.rows(), dataMatrix.cols()));
+
+    MatrixXd rangeMatrix = __orthonormalizeColumns(dataMatrix *
+        __calcRandomNormalMatrix(dataMatrix.cols(), sampleNum, __PCA_RANDOM_SEED));
+
+    for (int iterIdx = 0; iterIdx < __PCA_POWER_ITER_NUM; iterIdx++)
+    {
+        rangeMatrix = __orthonormalizeColumns(dataMatrix *
+            __orthonormalizeColumns(dataMatrix.transpose() * rangeMatrix));
+    }
+
+    // The sampleNum * 3N Projection Has The Same Leading Right Singular Pairs
+    MatrixXd projectedMatrix = rangeMatrix.transpose() * dataMatrix;
+
+    return __calcTopRightSingularPairs(projectedMatrix, modeNum);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+PCA::PCA(const vector<MatrixX3d> &coordMatrixList, int modeNum, int alignIterNum)
+{
+    int modelNum = coordMatrixList.size();
+
+    if (modelNum < 2)
+    {
+        throw runtime_error((format("At least 2 models are required, got %d") % modelNum).str());
+    }
+
+    int atomNum = coordMatrixList[0].rows(), dimNum = atomNum * 3;
+
+    for (int modelIdx = 1; modelIdx < modelNum; modelIdx++)
+    {
+        if (coordMatrixList[modelIdx].rows() != atomNum)
+        {
+            throw runtime_error((format("Coord matrix size mismatch: model %d has %d atoms, model 0 has %d") %
+                modelIdx % coordMatrixList[modelIdx].rows() % atomNum).str());
+        }
+    }
+
+    // One Row Per Model, Atom-Major (x1, y1, z1, x2, ...)
+    Matrix<double, Dynamic, Dynamic, RowMajor> dataMatrix(modelNum, dimNum);
+
+    RowVectorXd meanList;
+
+    __meanCoordMatrix = coordMatrixList[0];
+
+    // Superimpose Onto The First Model, Then Onto The Mean Structure Of The Previous Round
+    for (int alignIdx = 0; alignIdx < max(alignIterNum, 1); alignIdx++)
+    {
+        // The Reference Of The Last Round Is Kept, So That project() Aligns Exactly As The Stored Frames
+        __refCoordMatrix = __meanCoordMatrix;
+
+        #pragma omp parallel for schedule(static)
+        for (int modelIdx = 0; modelIdx < modelNum; modelIdx++)
+        {
+            auto [srcCenterCoord, rotationMatrix, tarCenterCoord] =
+                calcSuperimposeRotationMatrix(__refCoordMatrix, coordMatrixList[modelIdx]);
+
+            Map<Matrix<double, Dynamic, 3, RowMajor>>(dataMatrix.row(modelIdx).data(), atomNum, 3) =
+                ((coordMatrixList[modelIdx].rowwise() - srcCenterCoord) * rotationMatrix).rowwise() + tarCenterCoord;
+        }
+
+        meanList = dataMatrix.colwise().mean();
+
+        __meanCoordMatrix = Map<Matrix<double, Dynamic, 3, RowMajor>>(meanList.data(), atomNum, 3);
+    }
+
+    dataMatrix.rowwise() -= meanList;
+
+    __totalVariance = dataMatrix.squaredNorm() / modelNum;
+
+    auto [squaredSingularValueList, rightSingularMatrix] = min(modelNum, dimNum) <= __PCA_EXACT_MAX_DIM ?
+        __calcTopRightSingularPairs(dataMatrix, modeNum) :
+        __calcRandomizedTopRightSingularPairs(dataMatrix, modeNum);
+
+    // Deterministic Sign: The Largest Component Of Each Mode Is Positive
+    for (int modeIdx = 0; modeIdx < rightSingularMatrix.cols(); modeIdx++)
+    {
+        int maxIdx;
+
+        rightSingularMatrix.col(modeIdx).cwiseAbs().maxCoeff(&maxIdx);
+
+        if (rightSingularMatrix(maxIdx, modeIdx) < 0.)
+        {
+            rightSingularMatrix.col(modeIdx) = -rightSingularMatrix.col(modeIdx);
+        }
+    }
+
+    __eigenvalueList   = squaredSingularValueList / modelNum;
+    __modeMatrix       = rightSingularMatrix;
+    __projectionMatrix = dataMatrix * __modeMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __meanCoordMatrix
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const MatrixX3d &PCA::meanCoordMatrix() const
+{
+    return __meanCoordMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __eigenvalueList
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const VectorXd &PCA::eigenvalueList() const
+{
+    return __eigenvalueList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __modeMatrix
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const MatrixXd &PCA::modeMatrix() const
+{
+    return __modeMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __totalVariance
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double PCA::totalVariance() const
+{
+    return __totalVariance;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __projectionMatrix
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const MatrixXd &PCA::projectionMatrix() const
+{
+    return __projectionMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Project (Superimpose Onto The Last Alignment Reference, Then Project The Deviation From The Mean Onto The Modes)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorXd PCA::project(const Ref<const MatrixX3d> &coordMatrix) const
+{
+    if (coordMatrix.rows() != __meanCoordMatrix.rows())
+    {
+        throw runtime_error((format("Coord matrix size mismatch: %d vs %d") %
+            __meanCoordMatrix.rows() % coordMatrix.rows()).str());
+    }
+
+    auto [srcCenterCoord, rotationMatrix, tarCenterCoord] =
+        calcSuperimposeRotationMatrix(__refCoordMatrix, coordMatrix);
+
+    Matrix<double, Dynamic, 3, RowMajor> deltaMatrix =
+        (((coordMatrix.rowwise() - srcCenterCoord) * rotationMatrix).rowwise() + tarCenterCoord) - __meanCoordMatrix;
+
+    return __modeMatrix.transpose() * Map<const VectorXd>(deltaMatrix.data(), deltaMatrix.size());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reconstruct (Mean Structure + The Leading projectionList.size() Modes)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MatrixX3d PCA::reconstruct(const Ref<const VectorXd> &projectionList) const
+{
+    if (projectionList.size() > __modeMatrix.cols())
+    {
+        throw runtime_error((format("Too many projections: %d (mode number: %d)") %
+            projectionList.size() % __modeMatrix.cols()).str());
+    }
+
+    VectorXd deltaList = __modeMatrix.leftCols(projectionList.size()) * projectionList;
+
+    return __meanCoordMatrix + Map<const Matrix<double, Dynamic, 3, RowMajor>>(deltaList.data(),
+        __meanCoordMatrix.rows(), 3);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Mode Coord (Structure Displaced Along One Mode)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MatrixX3d PCA::calcModeCoord(int modeIdx, double projection) const
+{
+    if (modeIdx < 0 || modeIdx >= __modeMatrix.cols())
+    {
+        throw runtime_error((format("Invalid mode index: %d (mode number: %d)") % modeIdx % __modeMatrix.cols()).str());
+    }
+
+    return __meanCoordMatrix + projection * Map<const Matrix<double, Dynamic, 3, RowMajor>>(
+        __modeMatrix.col(modeIdx).data(), __meanCoordMatrix.rows(), 3);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// str
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string PCA::__str() const
+{
+    return (format("<PCA object: %d atoms, %d modes, at %p>") % __meanCoordMatrix.rows() % __modeMatrix.cols() %
+        this).str();
+}
+
+
+}  // End namespace PDBTools
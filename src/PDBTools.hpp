@@ -11,6 +11,28 @@
 #include "Chain.hpp"
 #include "Residue.hpp"
 #include "Atom.hpp"
+#include "InternalChain.hpp"
+#include "CellList.hpp"
+#include "KDTree.hpp"
+#include "PairExclusion.hpp"
+#include "ClashChecker.hpp"
+#include "EnergyScorer.hpp"
+#include "ScoreTracker.hpp"
+#include "AtomTable.hpp"
+#include "Selection.hpp"
+#include "ModelReader.hpp"
+#include "TrajectoryStats.hpp"
+#include "PCA.hpp"
 #include "Util.hpp"
 #include "Math.hpp"
+#include "BatchRMSD.hpp"
+#include "SymmetryRMSD.hpp"
+#include "TMScore.hpp"
+#include "StructAlign.hpp"
+#include "Cluster.hpp"
+#include "ENM.hpp"
+#include "TorsionMinimize.hpp"
+#include "ContactMap.hpp"
+#include "SASA.hpp"
+#include "DSSP.hpp"
 #include "Constants.hpp"
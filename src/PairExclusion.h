@@ -0,0 +1,55 @@
+/*
+    PairExclusion.h
+    ===============
+        Class __PairExclusion header.
+*/
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include "Predecl.h"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::vector;
+using std::pair;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Class __PairExclusion (Bond Topology Of The Atoms Checked By ClashChecker And EnergyScorer)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class __PairExclusion
+{
+public:
+
+    // Constructor
+    explicit __PairExclusion(const vector<Atom *> &atomPtrList, double bondLengthCutoff = 2.);
+
+
+    // Is Excluded Pair (1-2 Pair Or 1-3 Pair)
+    bool isExcludedPair(int atomIdxI, int atomIdxJ) const;
+
+
+    // Is 1-4 Pair
+    bool is14Pair(int atomIdxI, int atomIdxJ) const;
+
+
+private:
+
+    // Data
+    vector<vector<pair<int, int>>> __nearAtomIdxListList;
+
+
+    // Bond Separation
+    int __bondSeparation(int atomIdxI, int atomIdxJ) const;
+};
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,249 @@
+/*
+    PairExclusion.hpp
+    =================
+        Class __PairExclusion implementation.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <stdexcept>
+#include <boost/format.hpp>
+#include "PairExclusion.h"
+#include "Chain.h"
+#include "Residue.h"
+#include "Atom.h"
+#include "Util.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::pair;
+using std::runtime_error;
+using boost::format;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Pair Exclusion Parameters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SG - SG Pairs Closer Than This (In Any Residues) Are Disulfide Bonds
+const double __DISULFIDE_BOND_LENGTH_CUTOFF = 2.5;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+__PairExclusion::__PairExclusion(const vector<Atom *> &atomPtrList, double bondLengthCutoff):
+    __nearAtomIdxListList(atomPtrList.size())
+{
+    int atomNum = atomPtrList.size();
+
+    vector<Residue *> resPtrList;
+    unordered_map<Residue *, vector<int>> resAtomIdxListMap;
+    unordered_map<Residue *, int> resIdxMap;
+    vector<bool> hBoolList(atomNum);
+    vector<int> sgIdxList;
+
+    for (int atomIdx = 0; atomIdx < atomNum; atomIdx++)
+    {
+        auto atomPtr = atomPtrList[atomIdx];
+        auto resPtr  = atomPtr->owner();
+
+        hBoolList[atomIdx] = getElement(atomPtr) == "H";
+
+        if (atomPtr->name() == "SG")
+        {
+            sgIdxList.push_back(atomIdx);
+        }
+
+        if (!resPtr)
+        {
+            continue;
+        }
+
+        if (!resAtomIdxListMap.count(resPtr))
+        {
+            resPtrList.push_back(resPtr);
+
+            // Number All Residues Of The Chain In One Pass
+            if (resPtr->owner() && !resIdxMap.count(resPtr))
+            {
+                auto chainPtr = resPtr->owner();
+
+                for (int resIdx = 0; resIdx < (int) chainPtr->sub().size(); resIdx++)
+                {
+                    resIdxMap[chainPtr->sub()[resIdx]] = resIdx;
+                }
+            }
+        }
+
+        resAtomIdxListMap[resPtr].push_back(atomIdx);
+    }
+
+    // Bond: Two Atoms (Not Both Hydrogen) Of The Same Or Adjacent Residues Closer Than bondLengthCutoff
+    vector<vector<int>> bondIdxListList(atomNum);
+    vector<int> searchIdxList;
+
+    double squaredBondLengthCutoff = bondLengthCutoff * bondLengthCutoff;
+
+    for (auto resPtr: resPtrList)
+    {
+        auto &atomIdxList = resAtomIdxListMap[resPtr];
+
+        searchIdxList = atomIdxList;
+
+        if (resIdxMap.count(resPtr) && resIdxMap[resPtr] > 0)
+        {
+            auto lastResIter = resAtomIdxListMap.find(resPtr->owner()->sub()[resIdxMap[resPtr] - 1]);
+
+            if (lastResIter != resAtomIdxListMap.end())
+            {
+                searchIdxList.insert(searchIdxList.end(), lastResIter->second.begin(), lastResIter->second.end());
+            }
+        }
+
+        for (int atomIdxI: atomIdxList)
+        {
+            for (int atomIdxJ: searchIdxList)
+            {
+                // Each Intra-Residue Pair Once, Each Inter-Residue Pair From The Later Residue
+                if (atomIdxI == atomIdxJ || (atomPtrList[atomIdxJ]->owner() == resPtr && atomIdxJ < atomIdxI))
+                {
+                    continue;
+                }
+
+                if ((atomPtrList[atomIdxI]->coord() - atomPtrList[atomIdxJ]->coord()).squaredNorm() <
+                    squaredBondLengthCutoff && !(hBoolList[atomIdxI] && hBoolList[atomIdxJ]))
+                {
+                    bondIdxListList[atomIdxI].push_back(atomIdxJ);
+                    bondIdxListList[atomIdxJ].push_back(atomIdxI);
+                }
+            }
+        }
+    }
+
+    // Disulfide Bond
+    double squaredDisulfideCutoff = __DISULFIDE_BOND_LENGTH_CUTOFF * __DISULFIDE_BOND_LENGTH_CUTOFF;
+
+    for (int sgIdxI = 0; sgIdxI < (int) sgIdxList.size(); sgIdxI++)
+    {
+        for (int sgIdxJ = sgIdxI + 1; sgIdxJ < (int) sgIdxList.size(); sgIdxJ++)
+        {
+            int atomIdxI = sgIdxList[sgIdxI], atomIdxJ = sgIdxList[sgIdxJ];
+
+            if ((atomPtrList[atomIdxI]->coord() - atomPtrList[atomIdxJ]->coord()).squaredNorm() <
+                squaredDisulfideCutoff)
+            {
+                bondIdxListList[atomIdxI].push_back(atomIdxJ);
+                bondIdxListList[atomIdxJ].push_back(atomIdxI);
+            }
+        }
+    }
+
+    // All Atoms Within 3 Bonds, With The Bond Separation
+    for (int atomIdx = 0; atomIdx < atomNum; atomIdx++)
+    {
+        auto &nearAtomIdxList = __nearAtomIdxListList[atomIdx];
+
+        vector<int> frontierIdxList {atomIdx};
+
+        for (int bondNum = 1; bondNum <= 3; bondNum++)
+        {
+            vector<int> nextFrontierIdxList;
+
+            for (int frontierIdx: frontierIdxList)
+            {
+                for (int bondedIdx: bondIdxListList[frontierIdx])
+                {
+                    if (bondedIdx != atomIdx && !__bondSeparation(atomIdx, bondedIdx))
+                    {
+                        nearAtomIdxList.emplace_back(bondedIdx, bondNum);
+                        nextFrontierIdxList.push_back(bondedIdx);
+                    }
+                }
+            }
+
+            frontierIdxList.swap(nextFrontierIdxList);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Is Excluded Pair
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool __PairExclusion::isExcludedPair(int atomIdxI, int atomIdxJ) const
+{
+    int bondNum = __bondSeparation(atomIdxI, atomIdxJ);
+
+    return bondNum == 1 || bondNum == 2;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Is 1-4 Pair
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool __PairExclusion::is14Pair(int atomIdxI, int atomIdxJ) const
+{
+    return __bondSeparation(atomIdxI, atomIdxJ) == 3;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Bond Separation (Bond Number Between Two Atoms, 0 If More Than 3 Or Not Connected)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int __PairExclusion::__bondSeparation(int atomIdxI, int atomIdxJ) const
+{
+    for (auto [nearAtomIdx, bondNum]: __nearAtomIdxListList[atomIdxI])
+    {
+        if (nearAtomIdx == atomIdxJ)
+        {
+            return bondNum;
+        }
+    }
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Atom Idx List (All Atoms Are Checked Before The Caller Changes Any State)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<int> __getAtomIdxList(const unordered_map<Atom *, int> &atomIdxMap, const vector<Atom *> &atomPtrList,
+    const string &ownerName)
+{
+    vector<int> atomIdxList;
+
+    for (auto atomPtr: atomPtrList)
+    {
+        auto atomIdxIter = atomIdxMap.find(atomPtr);
+
+        if (atomIdxIter == atomIdxMap.end())
+        {
+            throw runtime_error((format("Atom %s is not in the %s") % atomPtr->name() % ownerName).str());
+        }
+
+        atomIdxList.push_back(atomIdxIter->second);
+    }
+
+    return atomIdxList;
+}
+
+
+}  // End namespace PDBTools
@@ -40,20 +40,12 @@ using Eigen::RowVector3d;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Load PDB File
+// PDB Parse State (Current Protein, Chain And Residue Of The Model Being Parsed)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Protein *load(const string &pdbFilePath, bool parseHBool = false)
+struct __PDBParseState
 {
-    ifstream f(pdbFilePath);
-    string line;
-
-    if (!f)
-    {
-        throw runtime_error(pdbFilePath + " not exists");
-    }
-
-    Protein *proPtr = new Protein(path(pdbFilePath).stem().string());
+    Protein *proPtr;
     Chain *chainPtr;
     Residue *resPtr;
 
@@ -62,77 +54,76 @@ Protein *load(const string &pdbFilePath, bool parseHBool = false)
     int lastResNum       = INT_MAX;
     string lastResIns    = " ";
 
-    while (getline(f, line))
-    {
-        if (line.substr(0, 4) != "ATOM")
-        {
-            continue;
-        }
+    explicit __PDBParseState(Protein *proPtr): proPtr(proPtr) {}
+};
 
-        string atomName = line.substr(12, 4);
 
-        trim(atomName);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Parse ATOM Line
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        if (isH(atomName) && !parseHBool)
-        {
-            continue;
-        }
+void __parseAtomLine(const string &line, __PDBParseState &stateObj, bool parseHBool)
+{
+    string atomName = line.substr(12, 4);
 
-        int atomNum       = stoi(line.substr(6, 5));
-        string atomAltLoc = line.substr(16, 1);
-        string resName    = line.substr(17, 3);
-        string chainName  = line.substr(21, 1);
-        int resNum        = stoi(line.substr(22, 4));
-        string resIns     = line.substr(26, 1);
+    trim(atomName);
 
-        trim(atomAltLoc);
-        trim(resName);
-        trim(chainName);
-        trim(resIns);
+    if (isH(atomName) && !parseHBool)
+    {
+        return;
+    }
 
-        RowVector3d atomCoord(stod(line.substr(30, 8)), stod(line.substr(38, 8)), stod(line.substr(46, 8)));
+    int atomNum       = stoi(line.substr(6, 5));
+    string atomAltLoc = line.substr(16, 1);
+    string resName    = line.substr(17, 3);
+    string chainName  = line.substr(21, 1);
+    int resNum        = stoi(line.substr(22, 4));
+    string resIns     = line.substr(26, 1);
 
-        string atomOccupancy  = line.size() > 54 ? line.substr(54, 6) : "";
-        string atomTempFactor = line.size() > 60 ? line.substr(60, 6) : "";
-        string atomElement    = line.size() > 76 ? line.substr(76, 2) : "";
-        string atomCharge     = line.size() > 78 ? line.substr(78, 2) : "";
+    trim(atomAltLoc);
+    trim(resName);
+    trim(chainName);
+    trim(resIns);
 
-        trim(atomOccupancy);
-        trim(atomTempFactor);
-        trim(atomElement);
-        trim(atomCharge);
+    RowVector3d atomCoord(stod(line.substr(30, 8)), stod(line.substr(38, 8)), stod(line.substr(46, 8)));
 
-        if (chainName != lastChainName)
-        {
-            lastChainName = chainName;
-            lastResNum    = resNum;
-            lastResName   = resName;
-            lastResIns    = resIns;
-            chainPtr      = new Chain(chainName, proPtr);
-            resPtr        = new Residue(resName, resNum, resIns, chainPtr);
-        }
-        else if (lastResNum != resNum || lastResName != resName || lastResIns != resIns)
-        {
-            lastResNum  = resNum;
-            lastResName = resName;
-            lastResIns  = resIns;
-            resPtr      = new Residue(resName, resNum, resIns, chainPtr);
-        }
+    string atomOccupancy  = line.size() > 54 ? line.substr(54, 6) : "";
+    string atomTempFactor = line.size() > 60 ? line.substr(60, 6) : "";
+    string atomElement    = line.size() > 76 ? line.substr(76, 2) : "";
+    string atomCharge     = line.size() > 78 ? line.substr(78, 2) : "";
 
-        new Atom(atomName, atomNum, atomCoord, atomAltLoc, atomOccupancy, atomTempFactor, atomElement, atomCharge, resPtr);
-    }
+    trim(atomOccupancy);
+    trim(atomTempFactor);
+    trim(atomElement);
+    trim(atomCharge);
 
-    f.close();
+    if (chainName != stateObj.lastChainName)
+    {
+        stateObj.lastChainName = chainName;
+        stateObj.lastResNum    = resNum;
+        stateObj.lastResName   = resName;
+        stateObj.lastResIns    = resIns;
+        stateObj.chainPtr      = new Chain(chainName, stateObj.proPtr);
+        stateObj.resPtr        = new Residue(resName, resNum, resIns, stateObj.chainPtr);
+    }
+    else if (stateObj.lastResNum != resNum || stateObj.lastResName != resName || stateObj.lastResIns != resIns)
+    {
+        stateObj.lastResNum  = resNum;
+        stateObj.lastResName = resName;
+        stateObj.lastResIns  = resIns;
+        stateObj.resPtr      = new Residue(resName, resNum, resIns, stateObj.chainPtr);
+    }
 
-    return proPtr;
+    new Atom(atomName, atomNum, atomCoord, atomAltLoc, atomOccupancy, atomTempFactor, atomElement, atomCharge,
+        stateObj.resPtr);
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Load PDB File With Model
+// Load PDB File
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-vector<Protein *> loadModel(const string &pdbFilePath, bool parseHBool = false)
+Protein *load(const string &pdbFilePath, bool parseHBool = false)
 {
     ifstream f(pdbFilePath);
     string line;
@@ -142,87 +133,51 @@ vector<Protein *> loadModel(const string &pdbFilePath, bool parseHBool = false)
         throw runtime_error(pdbFilePath + " not exists");
     }
 
-    string proName = path(pdbFilePath).stem().string();
-    Protein *proPtr = new Protein(proName);
-    vector<Protein *> proPtrList {proPtr};
-    Chain *chainPtr;
-    Residue *resPtr;
-
-    string lastChainName = " ";
-    string lastResName   = " ";
-    int lastResNum       = INT_MAX;
-    string lastResIns    = " ";
+    __PDBParseState stateObj(new Protein(path(pdbFilePath).stem().string()));
 
     while (getline(f, line))
     {
-        if (line.compare(0, 5, "MODEL") == 0)
+        if (line.substr(0, 4) == "ATOM")
         {
-            proPtr = new Protein(proName, stoi(line.substr(10, 4)));
-            proPtrList.push_back(proPtr);
-
-            lastChainName = " ";
-            lastResName   = " ";
-            lastResNum    = INT_MAX;
-            lastResIns    = " ";
-
-            continue;
+            __parseAtomLine(line, stateObj, parseHBool);
         }
-        else if (line.compare(0, 4, "ATOM") != 0)
-        {
-            continue;
-        }
-
-        string atomName = line.substr(12, 4);
+    }
 
-        trim(atomName);
+    f.close();
 
-        if (isH(atomName) && !parseHBool)
-        {
-            continue;
-        }
+    return stateObj.proPtr;
+}
 
-        int atomNum       = stoi(line.substr(6, 5));
-        string atomAltLoc = line.substr(16, 1);
-        string resName    = line.substr(17, 3);
-        string chainName  = line.substr(21, 1);
-        int resNum        = stoi(line.substr(22, 4));
-        string resIns     = line.substr(26, 1);
 
-        trim(atomAltLoc);
-        trim(resName);
-        trim(chainName);
-        trim(resIns);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Load PDB File With Model
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        RowVector3d atomCoord(stod(line.substr(30, 8)), stod(line.substr(38, 8)), stod(line.substr(46, 8)));
+vector<Protein *> loadModel(const string &pdbFilePath, bool parseHBool = false)
+{
+    ifstream f(pdbFilePath);
+    string line;
 
-        string atomOccupancy  = line.size() > 54 ? line.substr(54, 6) : "";
-        string atomTempFactor = line.size() > 60 ? line.substr(60, 6) : "";
-        string atomElement    = line.size() > 76 ? line.substr(76, 2) : "";
-        string atomCharge     = line.size() > 78 ? line.substr(78, 2) : "";
+    if (!f)
+    {
+        throw runtime_error(pdbFilePath + " not exists");
+    }
 
-        trim(atomOccupancy);
-        trim(atomTempFactor);
-        trim(atomElement);
-        trim(atomCharge);
+    string proName = path(pdbFilePath).stem().string();
+    __PDBParseState stateObj(new Protein(proName));
+    vector<Protein *> proPtrList {stateObj.proPtr};
 
-        if (chainName != lastChainName)
+    while (getline(f, line))
+    {
+        if (line.compare(0, 5, "MODEL") == 0)
         {
-            lastChainName = chainName;
-            lastResNum    = resNum;
-            lastResName   = resName;
-            lastResIns    = resIns;
-            chainPtr      = new Chain(chainName, proPtr);
-            resPtr        = new Residue(resName, resNum, resIns, chainPtr);
+            stateObj = __PDBParseState(new Protein(proName, stoi(line.substr(10, 4))));
+            proPtrList.push_back(stateObj.proPtr);
         }
-        else if (lastResNum != resNum || lastResName != resName || lastResIns != resIns)
+        else if (line.compare(0, 4, "ATOM") == 0)
         {
-            lastResNum  = resNum;
-            lastResName = resName;
-            lastResIns  = resIns;
-            resPtr      = new Residue(resName, resNum, resIns, chainPtr);
+            __parseAtomLine(line, stateObj, parseHBool);
         }
-
-        new Atom(atomName, atomNum, atomCoord, atomAltLoc, atomOccupancy, atomTempFactor, atomElement, atomCharge, resPtr);
     }
 
     f.close();
@@ -0,0 +1,180 @@
+/*
+    SASA.hpp
+    ========
+        Solvent accessible surface area functions implementation.
+*/
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <boost/format.hpp>
+#include <Eigen/Dense>
+#include "Residue.h"
+#include "Atom.h"
+#include "CellList.hpp"
+#include "Util.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::vector;
+using std::pair;
+using std::sort;
+using std::sqrt;
+using std::cos;
+using std::sin;
+using std::runtime_error;
+using boost::format;
+using Eigen::RowVector3d;
+using Eigen::MatrixX3d;
+using Eigen::VectorXd;
+using Eigen::Array;
+using Eigen::Dynamic;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Sphere Points (Golden Spiral, Unit Sphere)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MatrixX3d __calcSpherePoints(int pointNum)
+{
+    MatrixX3d pointMatrix(pointNum, 3);
+
+    double goldenAngle = M_PI * (3. - sqrt(5.));
+
+    for (int pointIdx = 0; pointIdx < pointNum; pointIdx++)
+    {
+        double zCoord = 1. - (2. * pointIdx + 1.) / pointNum;
+        double xyRadius = sqrt(1. - zCoord * zCoord);
+
+        pointMatrix.row(pointIdx) << xyRadius * cos(goldenAngle * pointIdx),
+            xyRadius * sin(goldenAngle * pointIdx), zCoord;
+    }
+
+    return pointMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Atoms SASA (Shrake-Rupley)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorXd calcAtomsSASA(const vector<Atom *> &atomPtrList, double probeRadius = 1.4, int pointNum = 960)
+{
+    if (pointNum <= 0)
+    {
+        throw runtime_error((format("Invalid sphere point number: %d") % pointNum).str());
+    }
+
+    int atomNum = atomPtrList.size();
+
+    VectorXd sasaList = VectorXd::Zero(atomNum);
+
+    if (atomNum == 0)
+    {
+        return sasaList;
+    }
+
+    MatrixX3d coordMatrix(atomNum, 3);
+    VectorXd radiusList(atomNum);
+
+    for (int atomIdx = 0; atomIdx < atomNum; atomIdx++)
+    {
+        coordMatrix.row(atomIdx) = atomPtrList[atomIdx]->coord();
+        radiusList[atomIdx]      = getVdwRadius(atomPtrList[atomIdx]) + probeRadius;
+    }
+
+    double maxRadius = radiusList.maxCoeff();
+
+    CellList cellListObj(coordMatrix, 2. * maxRadius);
+    MatrixX3d pointMatrix = __calcSpherePoints(pointNum);
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (int atomIdx = 0; atomIdx < atomNum; atomIdx++)
+    {
+        RowVector3d atomCoord = coordMatrix.row(atomIdx);
+        double atomRadius = radiusList[atomIdx];
+
+        // Nearest Neighbors First: They Bury The Most Points, So The All-Buried Exit Fires Early
+        vector<pair<double, int>> neighborList;
+
+        for (int neighborIdx: cellListObj.queryRadius(atomCoord, atomRadius + maxRadius))
+        {
+            double squaredDis = (coordMatrix.row(neighborIdx) - atomCoord).squaredNorm();
+            double sumRadius  = atomRadius + radiusList[neighborIdx];
+
+            if (neighborIdx != atomIdx && squaredDis < sumRadius * sumRadius)
+            {
+                neighborList.emplace_back(squaredDis, neighborIdx);
+            }
+        }
+
+        sort(neighborList.begin(), neighborList.end());
+
+        Array<bool, Dynamic, 1> buriedBoolList = Array<bool, Dynamic, 1>::Constant(pointNum, false);
+
+        for (int idx = 0; idx < (int) neighborList.size(); idx++)
+        {
+            int neighborIdx = neighborList[idx].second;
+
+            // Sphere Points Relative To The Neighbor Center, One Column Per Dimension
+            RowVector3d shiftCoord = atomCoord - coordMatrix.row(neighborIdx);
+            double squaredNeighborRadius = radiusList[neighborIdx] * radiusList[neighborIdx];
+
+            buriedBoolList = buriedBoolList ||
+                ((pointMatrix.col(0).array() * atomRadius + shiftCoord[0]).square() +
+                 (pointMatrix.col(1).array() * atomRadius + shiftCoord[1]).square() +
+                 (pointMatrix.col(2).array() * atomRadius + shiftCoord[2]).square() < squaredNeighborRadius);
+
+            if (idx % 8 == 7 && buriedBoolList.all())
+            {
+                break;
+            }
+        }
+
+        sasaList[atomIdx] = 4. * M_PI * atomRadius * atomRadius * (pointNum - buriedBoolList.count()) / pointNum;
+    }
+
+    return sasaList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Residues SASA
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorXd calcResiduesSASA(const vector<Residue *> &resPtrList, double probeRadius = 1.4, int pointNum = 960)
+{
+    vector<Atom *> atomPtrList;
+    vector<int> resIdxList;
+
+    for (int resIdx = 0; resIdx < (int) resPtrList.size(); resIdx++)
+    {
+        for (auto atomPtr: *resPtrList[resIdx])
+        {
+            atomPtrList.push_back(atomPtr);
+            resIdxList.push_back(resIdx);
+        }
+    }
+
+    VectorXd atomSASAList = calcAtomsSASA(atomPtrList, probeRadius, pointNum);
+    VectorXd resSASAList  = VectorXd::Zero(resPtrList.size());
+
+    for (int atomIdx = 0; atomIdx < (int) atomPtrList.size(); atomIdx++)
+    {
+        resSASAList[resIdxList[atomIdx]] += atomSASAList[atomIdx];
+    }
+
+    return resSASAList;
+}
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,107 @@
+/*
+    ScoreTracker.h
+    ==============
+        Class ScoreTracker header.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <iostream>
+#include "Predecl.h"
+#include "CellList.h"
+#include "Constants.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::function;
+using std::ostream;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Class ScoreTracker
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ScoreTracker
+{
+    // Friend
+    friend ostream &operator<<(ostream &os, const ScoreTracker &scoreTrackerObj);
+
+
+public:
+
+    // Constructor
+    explicit ScoreTracker(const vector<Atom *> &atomPtrList, double cellSize = 6.);
+
+
+    // Getter: __scoreList
+    const vector<double> &scoreList() const;
+
+
+    // Score
+    double score(int scoreIdx) const;
+
+
+    // Register Score (pairFunc(atomIdxI, atomIdxJ, dis), atomIdxI < atomIdxJ, Summed Over Pairs Within cutoff)
+    ScoreTracker *registerScore(const function<double(int, int, double)> &pairFunc, double cutoff);
+
+
+    // Update (All Atoms, Recalc All Scores)
+    ScoreTracker *update();
+
+
+    // Update (Moved Atoms)
+    ScoreTracker *update(const vector<Atom *> &movedAtomPtrList, bool rigidBool = false);
+
+
+    // Rotate Backbone Dihedral Angle By Delta Angle
+    ScoreTracker *rotateBBDihedralAngleByDeltaAngle(Residue *resPtr, DIH dihedralEnum, SIDE sideEnum,
+        double deltaAngle);
+
+
+    // Rotate Side Chain Dihedral Angle By Delta Angle
+    ScoreTracker *rotateSCDihedralAngleByDeltaAngle(Residue *resPtr, int dihedralIdx, double deltaAngle);
+
+
+private:
+
+    // Data
+    vector<Atom *> __atomPtrList;
+    unordered_map<Atom *, int> __atomIdxMap;
+    CellList __cellList;
+    vector<function<double(int, int, double)>> __pairFuncList;
+    vector<double> __cutoffList;
+    vector<double> __scoreList;
+    double __maxCutoff;
+    vector<bool> __movedBoolList;
+
+
+    // Get Tracked Atom Ptr
+    vector<Atom *> __getTrackedAtomPtr(const vector<Atom *> &atomPtrList) const;
+
+
+    // Calc Full Score
+    double __calcFullScore(int scoreIdx) const;
+
+
+    // Accumulate Pair Scores
+    void __accumulatePairScores(const vector<int> &queryIdxList, bool rigidBool, double signVal);
+
+
+    // str
+    string __str() const;
+};
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,274 @@
+/*
+    ScoreTracker.hpp
+    ================
+        Class ScoreTracker implementation.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+#include <boost/format.hpp>
+#include "ScoreTracker.h"
+#include "Residue.h"
+#include "Atom.h"
+#include "PairExclusion.hpp"
+#include "CellList.hpp"
+#include "Util.hpp"
+#include "Constants.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::function;
+using std::min;
+using std::max;
+using boost::format;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ScoreTracker::ScoreTracker(const vector<Atom *> &atomPtrList, double cellSize):
+    __atomPtrList(atomPtrList),
+    __cellList(atomPtrList, cellSize),
+    __maxCutoff(0.),
+    __movedBoolList(atomPtrList.size())
+{
+    for (int atomIdx = 0; atomIdx < (int) atomPtrList.size(); atomIdx++)
+    {
+        __atomIdxMap[atomPtrList[atomIdx]] = atomIdx;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __scoreList
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const vector<double> &ScoreTracker::scoreList() const
+{
+    return __scoreList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Score
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double ScoreTracker::score(int scoreIdx) const
+{
+    return __scoreList[scoreIdx];
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Register Score (Index = Registration Order)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ScoreTracker *ScoreTracker::registerScore(const function<double(int, int, double)> &pairFunc, double cutoff)
+{
+    __pairFuncList.push_back(pairFunc);
+    __cutoffList.push_back(cutoff);
+    __scoreList.push_back(__calcFullScore(__scoreList.size()));
+
+    __maxCutoff = max(__maxCutoff, cutoff);
+
+    return this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Update (All Atoms, Recalc All Scores)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ScoreTracker *ScoreTracker::update()
+{
+    for (int atomIdx = 0; atomIdx < (int) __atomPtrList.size(); atomIdx++)
+    {
+        __cellList.update(atomIdx, __atomPtrList[atomIdx]->coord());
+    }
+
+    for (int scoreIdx = 0; scoreIdx < (int) __scoreList.size(); scoreIdx++)
+    {
+        __scoreList[scoreIdx] = __calcFullScore(scoreIdx);
+    }
+
+    return this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Update (Moved Atoms, rigidBool: All Moved Atoms Share One Rigid-Body Transform)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ScoreTracker *ScoreTracker::update(const vector<Atom *> &movedAtomPtrList, bool rigidBool)
+{
+    vector<int> movedIdxList;
+
+    for (int atomIdx: __getAtomIdxList(__atomIdxMap, movedAtomPtrList, "ScoreTracker"))
+    {
+        if (!__movedBoolList[atomIdx])
+        {
+            __movedBoolList[atomIdx] = true;
+            movedIdxList.push_back(atomIdx);
+        }
+    }
+
+    // A Rigid Move Only Changes Moved - Static Pairs, Which Can Be Scanned From The Smaller Side
+    vector<int> queryIdxList;
+
+    if (rigidBool && movedIdxList.size() * 2 > __atomPtrList.size())
+    {
+        for (int atomIdx = 0; atomIdx < (int) __atomPtrList.size(); atomIdx++)
+        {
+            if (!__movedBoolList[atomIdx])
+            {
+                queryIdxList.push_back(atomIdx);
+            }
+        }
+    }
+    else
+    {
+        queryIdxList = movedIdxList;
+    }
+
+    // Remove The Old Pair Scores, Sync The Moved Atoms, Then Add The New Pair Scores
+    __accumulatePairScores(queryIdxList, rigidBool, -1.);
+
+    for (int atomIdx: movedIdxList)
+    {
+        __cellList.update(atomIdx, __atomPtrList[atomIdx]->coord());
+    }
+
+    __accumulatePairScores(queryIdxList, rigidBool, 1.);
+
+    for (int atomIdx: movedIdxList)
+    {
+        __movedBoolList[atomIdx] = false;
+    }
+
+    return this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Rotate Backbone Dihedral Angle By Delta Angle
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ScoreTracker *ScoreTracker::rotateBBDihedralAngleByDeltaAngle(Residue *resPtr, DIH dihedralEnum, SIDE sideEnum,
+    double deltaAngle)
+{
+    resPtr->rotateBBDihedralAngleByDeltaAngle(dihedralEnum, sideEnum, deltaAngle);
+
+    return update(__getTrackedAtomPtr(resPtr->getBBRotationAtomPtr(dihedralEnum, sideEnum)), true);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Rotate Side Chain Dihedral Angle By Delta Angle
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ScoreTracker *ScoreTracker::rotateSCDihedralAngleByDeltaAngle(Residue *resPtr, int dihedralIdx, double deltaAngle)
+{
+    resPtr->rotateSCDihedralAngleByDeltaAngle(dihedralIdx, deltaAngle);
+
+    return update(__getTrackedAtomPtr(resPtr->getSCRotationAtomPtr(dihedralIdx)), true);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Tracked Atom Ptr (Rotated Atoms Outside A Subset Tracker Are Dropped)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<Atom *> ScoreTracker::__getTrackedAtomPtr(const vector<Atom *> &atomPtrList) const
+{
+    vector<Atom *> trackedAtomPtrList;
+
+    for (auto atomPtr: atomPtrList)
+    {
+        if (__atomIdxMap.count(atomPtr))
+        {
+            trackedAtomPtrList.push_back(atomPtr);
+        }
+    }
+
+    return trackedAtomPtrList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Full Score
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double ScoreTracker::__calcFullScore(int scoreIdx) const
+{
+    double scoreVal = 0.;
+
+    __cellList.forEachPair(__cutoffList[scoreIdx], [&](int atomIdxI, int atomIdxJ, double dis)
+    {
+        scoreVal += __pairFuncList[scoreIdx](atomIdxI, atomIdxJ, dis);
+    });
+
+    return scoreVal;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Accumulate Pair Scores (Pairs Changed By The Move, Scaled By signVal)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ScoreTracker::__accumulatePairScores(const vector<int> &queryIdxList, bool rigidBool, double signVal)
+{
+    for (int atomIdxI: queryIdxList)
+    {
+        for (int atomIdxJ: __cellList.queryRadius(__cellList.coordMatrix().row(atomIdxI), __maxCutoff))
+        {
+            // Moved - Static Pairs Always; Moved - Moved Pairs Once, And Only If The Move Is Not Rigid
+            if (__movedBoolList[atomIdxI] == __movedBoolList[atomIdxJ] &&
+                (rigidBool || !__movedBoolList[atomIdxI] || atomIdxJ <= atomIdxI))
+            {
+                continue;
+            }
+
+            double dis = (__cellList.coordMatrix().row(atomIdxI) - __cellList.coordMatrix().row(atomIdxJ)).norm();
+
+            for (int scoreIdx = 0; scoreIdx < (int) __scoreList.size(); scoreIdx++)
+            {
+                if (dis <= __cutoffList[scoreIdx])
+                {
+                    __scoreList[scoreIdx] += signVal *
+                        __pairFuncList[scoreIdx](min(atomIdxI, atomIdxJ), max(atomIdxI, atomIdxJ), dis);
+                }
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// str
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string ScoreTracker::__str() const
+{
+    return (format("<ScoreTracker object: %d atoms, %d scores, at %p>") %
+        __atomPtrList.size()                                            %
+        __scoreList.size()                                              %
+        this
+    ).str();
+}
+
+
+}  // End namespace PDBTools
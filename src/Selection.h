@@ -0,0 +1,134 @@
+/*
+    Selection.h
+    ===========
+        Class Selection header.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <boost/dynamic_bitset.hpp>
+#include "Predecl.h"
+#include "AtomTable.h"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::pair;
+using std::ostream;
+using boost::dynamic_bitset;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Selection Op Enum
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum class __SELECTION_OP
+{
+    ALL,
+    NONE,
+    BACKBONE,
+    CHAIN,
+    RESNAME,
+    RESNUM,
+    NAME,
+    ELEMENT,
+    WITHIN,
+    NOT,
+    AND,
+    OR,
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Selection Op (One Instruction Of The Postfix Program)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct __SelectionOp
+{
+    __SELECTION_OP opType;
+    vector<string> wordList          = {};
+    vector<pair<int, int>> rangeList = {};
+    double cutoff                    = 0.;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Class Selection
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Selection
+{
+    // Friend
+    friend ostream &operator<<(ostream &os, const Selection &selObj);
+
+
+public:
+
+    // Constructor
+    explicit Selection(const string &selStr);
+
+
+    // Getter: __selStr
+    const string &selStr() const;
+
+
+    // Evaluate
+    dynamic_bitset<> evaluate(const AtomTable &atomTableObj) const;
+
+
+    // Evaluate (Atom List)
+    dynamic_bitset<> evaluate(const vector<Atom *> &atomPtrList) const;
+
+
+    // Select
+    vector<Atom *> select(const vector<Atom *> &atomPtrList) const;
+
+
+private:
+
+    // Data
+    string __selStr;
+    vector<string> __tokenList;
+    vector<__SelectionOp> __opList;
+
+
+    // Parse Or
+    void __parseOr(int &tokenIdx);
+
+
+    // Parse And
+    void __parseAnd(int &tokenIdx);
+
+
+    // Parse Not
+    void __parseNot(int &tokenIdx);
+
+
+    // Parse Primary
+    void __parsePrimary(int &tokenIdx);
+
+
+    // Parse Word List
+    vector<string> __parseWordList(int &tokenIdx) const;
+
+
+    // Throw Syntax Error
+    [[noreturn]] void __throwSyntaxError(int tokenIdx, const string &reasonStr) const;
+
+
+    // str
+    string __str() const;
+};
+
+
+}  // End namespace PDBTools
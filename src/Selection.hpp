@@ -0,0 +1,518 @@
+/*
+    Selection.hpp
+    =============
+        Class Selection implementation.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <cctype>
+#include <charconv>
+#include <stdexcept>
+#include <boost/format.hpp>
+#include <boost/dynamic_bitset.hpp>
+#include <Eigen/Dense>
+#include "Selection.h"
+#include "AtomTable.hpp"
+#include "CellList.hpp"
+#include "Constants.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::unordered_set;
+using std::pair;
+using std::isspace;
+using std::from_chars;
+using std::errc;
+using std::runtime_error;
+using boost::format;
+using boost::dynamic_bitset;
+using Eigen::MatrixX3d;
+using Eigen::VectorXi;
+using Eigen::Array;
+using Eigen::Dynamic;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Selection Keywords (End Of A Word List)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const unordered_set<string> __SELECTION_KEYWORD_SET
+{
+    "and", "or", "not", "(", ")", "all", "none", "backbone",
+    "chain", "resname", "resnum", "name", "element", "within", "of",
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Match Selection Codes (Word => Code Lookup Table, Then One Gather Over The Code Column)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Array<bool, Dynamic, 1> __matchSelectionCodes(const unordered_map<string, int> &codeMap, const VectorXi &codeList,
+    const vector<string> &wordList)
+{
+    Array<bool, Dynamic, 1> codeBoolList = Array<bool, Dynamic, 1>::Constant(codeMap.size(), false);
+
+    for (auto &wordStr: wordList)
+    {
+        // Trailing '*': Prefix Match Against The Dictionary, Not The Atoms
+        if (wordStr.back() == '*')
+        {
+            string prefixStr = wordStr.substr(0, wordStr.size() - 1);
+
+            for (auto &[valStr, code]: codeMap)
+            {
+                if (valStr.compare(0, prefixStr.size(), prefixStr) == 0)
+                {
+                    codeBoolList[code] = true;
+                }
+            }
+        }
+        else
+        {
+            auto codeIter = codeMap.find(wordStr);
+
+            if (codeIter != codeMap.end())
+            {
+                codeBoolList[codeIter->second] = true;
+            }
+        }
+    }
+
+    return codeBoolList(codeList);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Within Bool List (Atoms Within cutoff Of Any Inner Atom, Inner Atoms Included)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Array<bool, Dynamic, 1> __calcWithinBoolList(const MatrixX3d &coordMatrix, const Array<bool, Dynamic, 1> &innerBoolList,
+    double cutoff)
+{
+    Array<bool, Dynamic, 1> withinBoolList = innerBoolList;
+
+    if (!innerBoolList.any())
+    {
+        return withinBoolList;
+    }
+
+    CellList cellListObj(coordMatrix, cutoff);
+
+    for (int atomIdx = 0; atomIdx < innerBoolList.size(); atomIdx++)
+    {
+        if (innerBoolList[atomIdx])
+        {
+            for (int neighborIdx: cellListObj.queryRadius(coordMatrix.row(atomIdx), cutoff))
+            {
+                withinBoolList[neighborIdx] = true;
+            }
+        }
+    }
+
+    return withinBoolList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Selection::Selection(const string &selStr):
+    __selStr(selStr)
+{
+    string tokenStr;
+
+    for (char c: selStr + " ")
+    {
+        if (isspace(c) || c == '(' || c == ')')
+        {
+            if (!tokenStr.empty())
+            {
+                __tokenList.push_back(tokenStr);
+                tokenStr.clear();
+            }
+
+            if (c == '(' || c == ')')
+            {
+                __tokenList.emplace_back(1, c);
+            }
+        }
+        else
+        {
+            tokenStr += c;
+        }
+    }
+
+    int tokenIdx = 0;
+
+    __parseOr(tokenIdx);
+
+    if (tokenIdx != (int) __tokenList.size())
+    {
+        __throwSyntaxError(tokenIdx, "unexpected token");
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __selStr
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const string &Selection::selStr() const
+{
+    return __selStr;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Evaluate
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+dynamic_bitset<> Selection::evaluate(const AtomTable &atomTableObj) const
+{
+    int atomNum = atomTableObj.size();
+
+    vector<Array<bool, Dynamic, 1>> boolListStack;
+
+    for (auto &opObj: __opList)
+    {
+        if (opObj.opType == __SELECTION_OP::ALL)
+        {
+            boolListStack.push_back(Array<bool, Dynamic, 1>::Constant(atomNum, true));
+        }
+        else if (opObj.opType == __SELECTION_OP::NONE)
+        {
+            boolListStack.push_back(Array<bool, Dynamic, 1>::Constant(atomNum, false));
+        }
+        else if (opObj.opType == __SELECTION_OP::BACKBONE)
+        {
+            boolListStack.push_back(__matchSelectionCodes(atomTableObj.__nameCodeMap, atomTableObj.__nameCodeList,
+                vector<string>(__BACKBONE_ATOM_NAME_SET.begin(), __BACKBONE_ATOM_NAME_SET.end())));
+        }
+        else if (opObj.opType == __SELECTION_OP::CHAIN)
+        {
+            boolListStack.push_back(__matchSelectionCodes(atomTableObj.__chainCodeMap, atomTableObj.__chainCodeList,
+                opObj.wordList));
+        }
+        else if (opObj.opType == __SELECTION_OP::RESNAME)
+        {
+            boolListStack.push_back(__matchSelectionCodes(atomTableObj.__resNameCodeMap,
+                atomTableObj.__resNameCodeList, opObj.wordList));
+        }
+        else if (opObj.opType == __SELECTION_OP::NAME)
+        {
+            boolListStack.push_back(__matchSelectionCodes(atomTableObj.__nameCodeMap, atomTableObj.__nameCodeList,
+                opObj.wordList));
+        }
+        else if (opObj.opType == __SELECTION_OP::ELEMENT)
+        {
+            boolListStack.push_back(__matchSelectionCodes(atomTableObj.__eleCodeMap, atomTableObj.__eleCodeList,
+                opObj.wordList));
+        }
+        else if (opObj.opType == __SELECTION_OP::RESNUM)
+        {
+            Array<bool, Dynamic, 1> resNumBoolList = Array<bool, Dynamic, 1>::Constant(atomNum, false);
+
+            for (auto [startNum, endNum]: opObj.rangeList)
+            {
+                resNumBoolList = resNumBoolList ||
+                    (atomTableObj.__resNumList.array() >= startNum && atomTableObj.__resNumList.array() <= endNum);
+            }
+
+            boolListStack.push_back(resNumBoolList);
+        }
+        else if (opObj.opType == __SELECTION_OP::WITHIN)
+        {
+            boolListStack.back() = __calcWithinBoolList(atomTableObj.__coordMatrix, boolListStack.back(),
+                opObj.cutoff);
+        }
+        else if (opObj.opType == __SELECTION_OP::NOT)
+        {
+            boolListStack.back() = !boolListStack.back();
+        }
+        else
+        {
+            Array<bool, Dynamic, 1> rightBoolList = boolListStack.back();
+
+            boolListStack.pop_back();
+
+            if (opObj.opType == __SELECTION_OP::AND)
+            {
+                boolListStack.back() = boolListStack.back() && rightBoolList;
+            }
+            else
+            {
+                boolListStack.back() = boolListStack.back() || rightBoolList;
+            }
+        }
+    }
+
+    dynamic_bitset<> atomBoolList(atomNum);
+
+    for (int atomIdx = 0; atomIdx < atomNum; atomIdx++)
+    {
+        if (boolListStack.back()[atomIdx])
+        {
+            atomBoolList.set(atomIdx);
+        }
+    }
+
+    return atomBoolList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Evaluate (Atom List)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+dynamic_bitset<> Selection::evaluate(const vector<Atom *> &atomPtrList) const
+{
+    return evaluate(AtomTable(atomPtrList));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Select
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<Atom *> Selection::select(const vector<Atom *> &atomPtrList) const
+{
+    auto atomBoolList = evaluate(atomPtrList);
+
+    vector<Atom *> selAtomPtrList;
+
+    for (auto atomIdx = atomBoolList.find_first(); atomIdx != dynamic_bitset<>::npos;
+        atomIdx = atomBoolList.find_next(atomIdx))
+    {
+        selAtomPtrList.push_back(atomPtrList[atomIdx]);
+    }
+
+    return selAtomPtrList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Parse Or
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Selection::__parseOr(int &tokenIdx)
+{
+    __parseAnd(tokenIdx);
+
+    while (tokenIdx < (int) __tokenList.size() && __tokenList[tokenIdx] == "or")
+    {
+        __parseAnd(++tokenIdx);
+        __opList.push_back({__SELECTION_OP::OR});
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Parse And
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Selection::__parseAnd(int &tokenIdx)
+{
+    __parseNot(tokenIdx);
+
+    while (tokenIdx < (int) __tokenList.size() && __tokenList[tokenIdx] == "and")
+    {
+        __parseNot(++tokenIdx);
+        __opList.push_back({__SELECTION_OP::AND});
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Parse Not
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Selection::__parseNot(int &tokenIdx)
+{
+    if (tokenIdx < (int) __tokenList.size() && __tokenList[tokenIdx] == "not")
+    {
+        __parseNot(++tokenIdx);
+        __opList.push_back({__SELECTION_OP::NOT});
+    }
+    else
+    {
+        __parsePrimary(tokenIdx);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Parse Primary
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Selection::__parsePrimary(int &tokenIdx)
+{
+    static const unordered_map<string, __SELECTION_OP> __SELECTION_WORD_OP_MAP
+    {
+        {"chain",   __SELECTION_OP::CHAIN},
+        {"resname", __SELECTION_OP::RESNAME},
+        {"name",    __SELECTION_OP::NAME},
+        {"element", __SELECTION_OP::ELEMENT},
+    };
+
+    if (tokenIdx == (int) __tokenList.size())
+    {
+        __throwSyntaxError(tokenIdx, "unexpected end");
+    }
+
+    const string &tokenStr = __tokenList[tokenIdx++];
+
+    if (tokenStr == "(")
+    {
+        __parseOr(tokenIdx);
+
+        if (tokenIdx == (int) __tokenList.size() || __tokenList[tokenIdx] != ")")
+        {
+            __throwSyntaxError(tokenIdx, "missing ')'");
+        }
+
+        tokenIdx++;
+    }
+    else if (tokenStr == "all")
+    {
+        __opList.push_back({__SELECTION_OP::ALL});
+    }
+    else if (tokenStr == "none")
+    {
+        __opList.push_back({__SELECTION_OP::NONE});
+    }
+    else if (tokenStr == "backbone")
+    {
+        __opList.push_back({__SELECTION_OP::BACKBONE});
+    }
+    else if (__SELECTION_WORD_OP_MAP.count(tokenStr))
+    {
+        __opList.push_back({__SELECTION_WORD_OP_MAP.at(tokenStr), __parseWordList(tokenIdx)});
+    }
+    else if (tokenStr == "resnum")
+    {
+        int startIdx = tokenIdx;
+
+        __SelectionOp opObj {__SELECTION_OP::RESNUM};
+
+        // N, Or N-M / N:M (A Leading '-' Is A Sign)
+        for (auto &wordStr: __parseWordList(tokenIdx))
+        {
+            auto sepIdx = wordStr.find_first_of("-:", 1);
+            auto sepPtr = wordStr.data() + (sepIdx == string::npos ? wordStr.size() : sepIdx);
+
+            int startNum, endNum;
+
+            auto [startPtr, startErr] = from_chars(wordStr.data(), sepPtr, startNum);
+            auto [endPtr, endErr]     = sepIdx == string::npos ? from_chars(wordStr.data(), sepPtr, endNum) :
+                from_chars(sepPtr + 1, wordStr.data() + wordStr.size(), endNum);
+
+            if (startErr != errc() || endErr != errc() || startPtr != sepPtr ||
+                endPtr != wordStr.data() + wordStr.size())
+            {
+                __throwSyntaxError(startIdx, "invalid residue number range '" + wordStr + "'");
+            }
+
+            opObj.rangeList.emplace_back(startNum, endNum);
+        }
+
+        __opList.push_back(opObj);
+    }
+    else if (tokenStr == "within")
+    {
+        if (tokenIdx == (int) __tokenList.size())
+        {
+            __throwSyntaxError(tokenIdx, "missing distance");
+        }
+
+        const string &cutoffStr = __tokenList[tokenIdx];
+
+        double cutoff;
+
+        auto [cutoffPtr, cutoffErr] = from_chars(cutoffStr.data(), cutoffStr.data() + cutoffStr.size(), cutoff);
+
+        if (cutoffErr != errc() || cutoffPtr != cutoffStr.data() + cutoffStr.size() || !(cutoff > 0.))
+        {
+            __throwSyntaxError(tokenIdx, "invalid distance");
+        }
+
+        if (++tokenIdx == (int) __tokenList.size() || __tokenList[tokenIdx] != "of")
+        {
+            __throwSyntaxError(tokenIdx, "missing 'of'");
+        }
+
+        __parseNot(++tokenIdx);
+        __opList.push_back({__SELECTION_OP::WITHIN, {}, {}, cutoff});
+    }
+    else
+    {
+        __throwSyntaxError(tokenIdx - 1, "unexpected token");
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Parse Word List
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<string> Selection::__parseWordList(int &tokenIdx) const
+{
+    vector<string> wordList;
+
+    while (tokenIdx < (int) __tokenList.size() && !__SELECTION_KEYWORD_SET.count(__tokenList[tokenIdx]))
+    {
+        wordList.push_back(__tokenList[tokenIdx++]);
+    }
+
+    if (wordList.empty())
+    {
+        __throwSyntaxError(tokenIdx, "missing value");
+    }
+
+    return wordList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Throw Syntax Error
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Selection::__throwSyntaxError(int tokenIdx, const string &reasonStr) const
+{
+    throw runtime_error((format("Invalid selection \"%s\": %s at token %d%s") %
+        __selStr                                                                %
+        reasonStr                                                               %
+        tokenIdx                                                                %
+        (tokenIdx < (int) __tokenList.size() ? " (" + __tokenList[tokenIdx] + ")" : "")
+    ).str());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// str
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string Selection::__str() const
+{
+    return (format("<Selection object: \"%s\", at %p>") %
+        __selStr                                        %
+        this
+    ).str();
+}
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,579 @@
+/*
+    StructAlign.hpp
+    ===============
+        Sequence-independent structure alignment functions implementation.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <tuple>
+#include <algorithm>
+#include <cmath>
+#include <Eigen/Dense>
+#include "Chain.h"
+#include "Residue.h"
+#include "Atom.h"
+#include "Math.hpp"
+#include "ContactMap.hpp"
+#include "TMScore.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::pair;
+using std::tuple;
+using std::get;
+using std::tie;
+using std::count;
+using std::min;
+using std::max;
+using std::abs;
+using std::pow;
+using Eigen::RowVector3d;
+using Eigen::Matrix3d;
+using Eigen::MatrixX3d;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+using Eigen::ArrayXd;
+using Eigen::RowVectorXd;
+using Eigen::Matrix;
+using Eigen::Array;
+using Eigen::Dynamic;
+using Eigen::RowMajor;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Struct Align Constants (Zhang & Skolnick, 2005)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const int    __STRUCT_ALIGN_MAX_DP_ITER      = 30;
+const int    __STRUCT_ALIGN_SEARCH_SEED_STEP = 40;
+const int    __STRUCT_ALIGN_MIN_GAPLESS_LEN  = 5;
+const double __STRUCT_ALIGN_SS_GAP_OPEN      = -1.;
+
+const vector<double> __STRUCT_ALIGN_GAP_OPEN_LIST {-0.6, 0.};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Struct Align Params (Search Scale From The Shorter Structure)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct __StructAlignParams
+{
+    double d0;
+    double d0Search;
+    double squaredD8;
+    int normLen;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc CA Secondary Structure (CA Distance Rules: H, E, T, Or C)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string __calcCASecondaryStructure(const MatrixX3d &coordMatrix)
+{
+    int resNum = coordMatrix.rows();
+
+    string ssStr(resNum, 'C');
+
+    for (int resIdx = 2; resIdx + 2 < resNum; resIdx++)
+    {
+        auto disFunc = [&](int offsetI, int offsetJ)
+        {
+            return (coordMatrix.row(resIdx + offsetI) - coordMatrix.row(resIdx + offsetJ)).norm();
+        };
+
+        double dis13 = disFunc(-2, 0), dis14 = disFunc(-2, 1), dis15 = disFunc(-2, 2);
+        double dis24 = disFunc(-1, 1), dis25 = disFunc(-1, 2), dis35 = disFunc(0, 2);
+
+        auto matchFunc = [&](double dis13Ref, double dis14Ref, double dis15Ref, double deltaDis)
+        {
+            return abs(dis15 - dis15Ref) < deltaDis && abs(dis14 - dis14Ref) < deltaDis &&
+                abs(dis25 - dis14Ref) < deltaDis && abs(dis13 - dis13Ref) < deltaDis &&
+                abs(dis24 - dis13Ref) < deltaDis && abs(dis35 - dis13Ref) < deltaDis;
+        };
+
+        if (matchFunc(5.45, 5.18, 6.37, 2.1))
+        {
+            ssStr[resIdx] = 'H';
+        }
+        else if (matchFunc(6.1, 10.4, 13., 1.42))
+        {
+            ssStr[resIdx] = 'E';
+        }
+        else if (dis15 < 8.)
+        {
+            ssStr[resIdx] = 'T';
+        }
+    }
+
+    return ssStr;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Struct Align DP (Needleman-Wunsch, Gap Penalty On Opening Only, No End Gap Penalty)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<int> __calcStructAlignDP(const Matrix<double, Dynamic, Dynamic, RowMajor> &scoreMatrix, double gapOpen)
+{
+    int tarLen = scoreMatrix.rows(), srcLen = scoreMatrix.cols();
+
+    Matrix<double, Dynamic, Dynamic, RowMajor> valMatrix = Matrix<double, Dynamic, Dynamic, RowMajor>::Zero(
+        tarLen + 1, srcLen + 1);
+
+    Matrix<double, Dynamic, Dynamic, RowMajor> diagMatrix = Matrix<double, Dynamic, Dynamic, RowMajor>::Zero(
+        tarLen + 1, srcLen + 1);
+
+    for (int tarIdx = 1; tarIdx <= tarLen; tarIdx++)
+    {
+        // Diagonal And Vertical Moves Only Read Row tarIdx - 1, So They Vectorize Across The Row
+        RowVectorXd diagValList = valMatrix.row(tarIdx - 1).head(srcLen) + scoreMatrix.row(tarIdx - 1);
+        RowVectorXd vertValList = valMatrix.row(tarIdx - 1).tail(srcLen) +
+            diagMatrix.row(tarIdx - 1).tail(srcLen) * gapOpen;
+
+        for (int srcIdx = 1; srcIdx <= srcLen; srcIdx++)
+        {
+            double diagVal = diagValList[srcIdx - 1];
+            double vertVal = vertValList[srcIdx - 1];
+            double horiVal = valMatrix(tarIdx, srcIdx - 1) + diagMatrix(tarIdx, srcIdx - 1) * gapOpen;
+
+            if (diagVal >= vertVal && diagVal >= horiVal)
+            {
+                valMatrix(tarIdx, srcIdx)  = diagVal;
+                diagMatrix(tarIdx, srcIdx) = 1.;
+            }
+            else
+            {
+                valMatrix(tarIdx, srcIdx) = max(vertVal, horiVal);
+            }
+        }
+    }
+
+    vector<int> alignIdxList(tarLen, -1);
+
+    for (int tarIdx = tarLen, srcIdx = srcLen; tarIdx > 0 && srcIdx > 0; )
+    {
+        if (diagMatrix(tarIdx, srcIdx))
+        {
+            alignIdxList[tarIdx - 1] = srcIdx - 1;
+            tarIdx--;
+            srcIdx--;
+        }
+        else
+        {
+            double vertVal = valMatrix(tarIdx - 1, srcIdx) + diagMatrix(tarIdx - 1, srcIdx) * gapOpen;
+            double horiVal = valMatrix(tarIdx, srcIdx - 1) + diagMatrix(tarIdx, srcIdx - 1) * gapOpen;
+
+            if (horiVal >= vertVal)
+            {
+                srcIdx--;
+            }
+            else
+            {
+                tarIdx--;
+            }
+        }
+    }
+
+    return alignIdxList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Gather Aligned Coord
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+pair<MatrixX3d, MatrixX3d> __gatherAlignedCoord(const MatrixX3d &tarCoordMatrix, const MatrixX3d &srcCoordMatrix,
+    const vector<int> &alignIdxList)
+{
+    int alignNum = alignIdxList.size() - count(alignIdxList.begin(), alignIdxList.end(), -1);
+
+    MatrixX3d tarAlignCoordMatrix(alignNum, 3), srcAlignCoordMatrix(alignNum, 3);
+
+    for (int tarIdx = 0, alignIdx = 0; tarIdx < (int) alignIdxList.size(); tarIdx++)
+    {
+        if (alignIdxList[tarIdx] >= 0)
+        {
+            tarAlignCoordMatrix.row(alignIdx) = tarCoordMatrix.row(tarIdx);
+            srcAlignCoordMatrix.row(alignIdx) = srcCoordMatrix.row(alignIdxList[tarIdx]);
+            alignIdx++;
+        }
+    }
+
+    return {tarAlignCoordMatrix, srcAlignCoordMatrix};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Align Score (Superposition Search Over The Aligned Pairs)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+tuple<double, RowVector3d, Matrix3d, RowVector3d> __calcAlignScore(const MatrixX3d &tarCoordMatrix,
+    const MatrixX3d &srcCoordMatrix, const vector<int> &alignIdxList, const __StructAlignParams &paramsObj,
+    int seedStep)
+{
+    auto [tarAlignCoordMatrix, srcAlignCoordMatrix] = __gatherAlignedCoord(tarCoordMatrix, srcCoordMatrix,
+        alignIdxList);
+
+    double squaredD0 = paramsObj.d0 * paramsObj.d0, squaredD8 = paramsObj.squaredD8;
+    int normLen = paramsObj.normLen;
+
+    return __searchSuperimposeScore(
+        __buildSuperimposeSearchCache(tarAlignCoordMatrix, srcAlignCoordMatrix, seedStep), paramsObj.d0Search,
+        [=](const ArrayXd &squaredDisList)
+        {
+            return (squaredDisList < squaredD8).select(1. / (1. + squaredDisList / squaredD0), 0.).sum() / normLen;
+        });
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Align Score Matrix (Under A Superposition, Tar Rows * Src Columns)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Matrix<double, Dynamic, Dynamic, RowMajor> __calcAlignScoreMatrix(const MatrixX3d &tarCoordMatrix,
+    const MatrixX3d &srcCoordMatrix, const RowVector3d &srcCenterCoord, const Matrix3d &rotationMatrix,
+    const RowVector3d &tarCenterCoord, double d0)
+{
+    MatrixX3d srcMovedCoordMatrix = ((srcCoordMatrix.rowwise() - srcCenterCoord) * rotationMatrix).rowwise() +
+        tarCenterCoord;
+
+    return (1. / (1. + __calcSquaredDistanceTile(tarCoordMatrix, srcMovedCoordMatrix).array() / (d0 * d0))).matrix();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Gapless Align (Best Threading Offset By A Quick Superposition Score)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<int> __calcGaplessAlign(const MatrixX3d &tarCoordMatrix, const MatrixX3d &srcCoordMatrix,
+    const __StructAlignParams &paramsObj)
+{
+    int tarLen = tarCoordMatrix.rows(), srcLen = srcCoordMatrix.rows();
+    int minAlignLen = min(min(tarLen, srcLen), max(min(tarLen, srcLen) / 2, __STRUCT_ALIGN_MIN_GAPLESS_LEN));
+
+    int minShift = minAlignLen - tarLen, shiftNum = srcLen - minAlignLen - minShift + 1;
+
+    VectorXd shiftScoreList(shiftNum);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int shiftIdx = 0; shiftIdx < shiftNum; shiftIdx++)
+    {
+        int startIdx = max(0, -(minShift + shiftIdx)), endIdx = min(tarLen, srcLen - (minShift + shiftIdx));
+
+        MatrixX3d tarAlignCoordMatrix = tarCoordMatrix.middleRows(startIdx, endIdx - startIdx);
+        MatrixX3d srcAlignCoordMatrix = srcCoordMatrix.middleRows(startIdx + minShift + shiftIdx, endIdx - startIdx);
+
+        // Kabsch On All Pairs, Then Twice On The Pairs Within d0Search
+        auto [srcCenterCoord, rotationMatrix, tarCenterCoord] = calcSuperimposeRotationMatrix(
+            tarAlignCoordMatrix, srcAlignCoordMatrix);
+
+        double maxScore = 0.;
+
+        for (int refineIdx = 0; refineIdx < 3; refineIdx++)
+        {
+            ArrayXd squaredDisList = ((((srcAlignCoordMatrix.rowwise() - srcCenterCoord) * rotationMatrix).rowwise() +
+                tarCenterCoord) - tarAlignCoordMatrix).rowwise().squaredNorm().array();
+
+            maxScore = max(maxScore, (squaredDisList < paramsObj.squaredD8).select(
+                1. / (1. + squaredDisList / (paramsObj.d0 * paramsObj.d0)), 0.).sum());
+
+            vector<int> selectIdxList;
+
+            for (int alignIdx = 0; alignIdx < squaredDisList.size(); alignIdx++)
+            {
+                if (squaredDisList[alignIdx] < paramsObj.d0Search * paramsObj.d0Search)
+                {
+                    selectIdxList.push_back(alignIdx);
+                }
+            }
+
+            if (refineIdx == 2 || selectIdxList.size() < __SUPERIMPOSE_SEARCH_MIN_SELECT_NUM)
+            {
+                break;
+            }
+
+            tie(srcCenterCoord, rotationMatrix, tarCenterCoord) = calcSuperimposeRotationMatrix(
+                tarAlignCoordMatrix(selectIdxList, Eigen::all), srcAlignCoordMatrix(selectIdxList, Eigen::all));
+        }
+
+        shiftScoreList[shiftIdx] = maxScore;
+    }
+
+    int maxShiftIdx;
+
+    shiftScoreList.maxCoeff(&maxShiftIdx);
+
+    vector<int> alignIdxList(tarLen, -1);
+
+    for (int tarIdx = 0; tarIdx < tarLen; tarIdx++)
+    {
+        int srcIdx = tarIdx + minShift + maxShiftIdx;
+
+        if (srcIdx >= 0 && srcIdx < srcLen)
+        {
+            alignIdxList[tarIdx] = srcIdx;
+        }
+    }
+
+    return alignIdxList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Iterate Struct Align DP (Superpose, Rescore, Realign, Until The Alignment Is Stable)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+pair<double, vector<int>> __iterateStructAlignDP(const MatrixX3d &tarCoordMatrix, const MatrixX3d &srcCoordMatrix,
+    const vector<int> &initAlignIdxList, const __StructAlignParams &paramsObj)
+{
+    pair<double, vector<int>> maxScorePair {-1., initAlignIdxList};
+
+    for (double gapOpen: __STRUCT_ALIGN_GAP_OPEN_LIST)
+    {
+        vector<int> alignIdxList = initAlignIdxList;
+
+        for (int iterIdx = 0; iterIdx < __STRUCT_ALIGN_MAX_DP_ITER; iterIdx++)
+        {
+            auto [score, srcCenterCoord, rotationMatrix, tarCenterCoord] = __calcAlignScore(tarCoordMatrix,
+                srcCoordMatrix, alignIdxList, paramsObj, __STRUCT_ALIGN_SEARCH_SEED_STEP);
+
+            if (score > maxScorePair.first)
+            {
+                maxScorePair = {score, alignIdxList};
+            }
+
+            auto newAlignIdxList = __calcStructAlignDP(__calcAlignScoreMatrix(tarCoordMatrix, srcCoordMatrix,
+                srcCenterCoord, rotationMatrix, tarCenterCoord, paramsObj.d0), gapOpen);
+
+            if (newAlignIdxList == alignIdxList)
+            {
+                break;
+            }
+
+            alignIdxList = newAlignIdxList;
+        }
+    }
+
+    return maxScorePair;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Struct Align (Alignment, TM-Score By Tar Length, TM-Score By Src Length, Superposition)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+tuple<vector<int>, double, double, RowVector3d, Matrix3d, RowVector3d> __structAlign(
+    const MatrixX3d &tarCoordMatrix, const MatrixX3d &srcCoordMatrix)
+{
+    int tarLen = tarCoordMatrix.rows(), srcLen = srcCoordMatrix.rows();
+
+    if (tarLen == 0 || srcLen == 0)
+    {
+        return {vector<int>(tarLen, -1), 0., 0., RowVector3d::Zero(), Matrix3d::Identity(), RowVector3d::Zero()};
+    }
+
+    auto paramsFunc = [](int normLen)
+    {
+        double d0 = __calcTMScoreD0(normLen), d8 = 1.5 * pow(normLen, 0.3) + 3.5;
+
+        return __StructAlignParams {d0, min(max(d0, 4.5), 8.), d8 * d8, normLen};
+    };
+
+    auto searchParamsObj = paramsFunc(min(tarLen, srcLen));
+
+    // Initial Alignments: Gapless Threading, Secondary Structure, And Both Combined
+    auto gaplessAlignIdxList = __calcGaplessAlign(tarCoordMatrix, srcCoordMatrix, searchParamsObj);
+
+    string tarSSStr = __calcCASecondaryStructure(tarCoordMatrix);
+    string srcSSStr = __calcCASecondaryStructure(srcCoordMatrix);
+
+    Matrix<double, Dynamic, Dynamic, RowMajor> ssScoreMatrix(tarLen, srcLen);
+
+    for (int tarIdx = 0; tarIdx < tarLen; tarIdx++)
+    {
+        for (int srcIdx = 0; srcIdx < srcLen; srcIdx++)
+        {
+            ssScoreMatrix(tarIdx, srcIdx) = tarSSStr[tarIdx] == srcSSStr[srcIdx];
+        }
+    }
+
+    auto [gaplessScore, srcCenterCoord, rotationMatrix, tarCenterCoord] = __calcAlignScore(tarCoordMatrix,
+        srcCoordMatrix, gaplessAlignIdxList, searchParamsObj, __STRUCT_ALIGN_SEARCH_SEED_STEP);
+
+    vector<vector<int>> initAlignIdxListList {
+        gaplessAlignIdxList,
+        __calcStructAlignDP(ssScoreMatrix, __STRUCT_ALIGN_SS_GAP_OPEN),
+        __calcStructAlignDP(__calcAlignScoreMatrix(tarCoordMatrix, srcCoordMatrix, srcCenterCoord,
+            rotationMatrix, tarCenterCoord, searchParamsObj.d0) + 0.5 * ssScoreMatrix, __STRUCT_ALIGN_SS_GAP_OPEN)
+    };
+
+    pair<double, vector<int>> maxScorePair {-1., {}};
+
+    for (auto &initAlignIdxList: initAlignIdxListList)
+    {
+        auto scorePair = __iterateStructAlignDP(tarCoordMatrix, srcCoordMatrix, initAlignIdxList, searchParamsObj);
+
+        if (scorePair.first > maxScorePair.first)
+        {
+            maxScorePair = scorePair;
+        }
+    }
+
+    // Final Superposition With Every Seed, Then Drop The Aligned Pairs Beyond d8
+    auto alignIdxList = maxScorePair.second;
+
+    tie(gaplessScore, srcCenterCoord, rotationMatrix, tarCenterCoord) = __calcAlignScore(tarCoordMatrix,
+        srcCoordMatrix, alignIdxList, searchParamsObj, 1);
+
+    for (int tarIdx = 0; tarIdx < tarLen; tarIdx++)
+    {
+        if (alignIdxList[tarIdx] >= 0 && ((srcCoordMatrix.row(alignIdxList[tarIdx]) - srcCenterCoord) *
+            rotationMatrix + tarCenterCoord - tarCoordMatrix.row(tarIdx)).squaredNorm() >= searchParamsObj.squaredD8)
+        {
+            alignIdxList[tarIdx] = -1;
+        }
+    }
+
+    auto tarParamsObj = paramsFunc(tarLen), srcParamsObj = paramsFunc(srcLen);
+
+    tarParamsObj.squaredD8 = srcParamsObj.squaredD8 = INFINITY;
+
+    auto [tarTMScore, finalSrcCenterCoord, finalRotationMatrix, finalTarCenterCoord] = __calcAlignScore(
+        tarCoordMatrix, srcCoordMatrix, alignIdxList, tarParamsObj, 1);
+
+    double srcTMScore = get<0>(__calcAlignScore(tarCoordMatrix, srcCoordMatrix, alignIdxList, srcParamsObj, 1));
+
+    return {alignIdxList, tarTMScore, srcTMScore, finalSrcCenterCoord, finalRotationMatrix, finalTarCenterCoord};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Struct Align A <= B (Coord Matrix)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+tuple<vector<pair<int, int>>, double, RowVector3d, Matrix3d, RowVector3d> calcStructAlign(
+    const MatrixX3d &tarCoordMatrix, const MatrixX3d &srcCoordMatrix)
+{
+    auto [alignIdxList, tarTMScore, srcTMScore, srcCenterCoord, rotationMatrix, tarCenterCoord] =
+        __structAlign(tarCoordMatrix, srcCoordMatrix);
+
+    vector<pair<int, int>> alignPairList;
+
+    for (int tarIdx = 0; tarIdx < (int) alignIdxList.size(); tarIdx++)
+    {
+        if (alignIdxList[tarIdx] >= 0)
+        {
+            alignPairList.emplace_back(tarIdx, alignIdxList[tarIdx]);
+        }
+    }
+
+    return {alignPairList, tarTMScore, srcCenterCoord, rotationMatrix, tarCenterCoord};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get CA Residues (Residues With A CA Atom, And The CA Coord Matrix)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+pair<vector<Residue *>, MatrixX3d> __getCAResidues(Chain *chainPtr)
+{
+    vector<Residue *> resPtrList;
+    vector<RowVector3d> coordList;
+
+    for (auto resPtr: *chainPtr)
+    {
+        for (auto atomPtr: *resPtr)
+        {
+            if (atomPtr->name() == "CA")
+            {
+                resPtrList.push_back(resPtr);
+                coordList.push_back(atomPtr->coord());
+                break;
+            }
+        }
+    }
+
+    MatrixX3d coordMatrix(coordList.size(), 3);
+
+    for (int resIdx = 0; resIdx < (int) coordList.size(); resIdx++)
+    {
+        coordMatrix.row(resIdx) = coordList[resIdx];
+    }
+
+    return {resPtrList, coordMatrix};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Struct Align A <= B (Chain)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+tuple<vector<pair<Residue *, Residue *>>, double, RowVector3d, Matrix3d, RowVector3d> calcStructAlign(
+    Chain *tarChainPtr, Chain *srcChainPtr)
+{
+    auto [tarResPtrList, tarCoordMatrix] = __getCAResidues(tarChainPtr);
+    auto [srcResPtrList, srcCoordMatrix] = __getCAResidues(srcChainPtr);
+
+    auto [alignPairList, tmScore, srcCenterCoord, rotationMatrix, tarCenterCoord] = calcStructAlign(
+        tarCoordMatrix, srcCoordMatrix);
+
+    vector<pair<Residue *, Residue *>> resPtrPairList;
+
+    for (auto [tarIdx, srcIdx]: alignPairList)
+    {
+        resPtrPairList.emplace_back(tarResPtrList[tarIdx], srcResPtrList[srcIdx]);
+    }
+
+    return {resPtrPairList, tmScore, srcCenterCoord, rotationMatrix, tarCenterCoord};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Struct Align TM-Score Matrix (All-vs-All, Row i Normalized By The Length Of Structure i)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MatrixXd calcStructAlignTMScoreMatrix(const vector<MatrixX3d> &coordMatrixList)
+{
+    int structNum = coordMatrixList.size();
+
+    MatrixXd tmScoreMatrix = MatrixXd::Identity(structNum, structNum);
+
+    vector<pair<int, int>> structPairList;
+
+    for (int structIdxI = 0; structIdxI < structNum; structIdxI++)
+    {
+        for (int structIdxJ = structIdxI + 1; structIdxJ < structNum; structIdxJ++)
+        {
+            structPairList.emplace_back(structIdxI, structIdxJ);
+        }
+    }
+
+    // Pair Costs Vary With Both Lengths, So Pairs Are Handed Out One At A Time
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int pairIdx = 0; pairIdx < (int) structPairList.size(); pairIdx++)
+    {
+        auto [structIdxI, structIdxJ] = structPairList[pairIdx];
+
+        auto alignTuple = __structAlign(coordMatrixList[structIdxI], coordMatrixList[structIdxJ]);
+
+        tmScoreMatrix(structIdxI, structIdxJ) = get<1>(alignTuple);
+        tmScoreMatrix(structIdxJ, structIdxI) = get<2>(alignTuple);
+    }
+
+    return tmScoreMatrix;
+}
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,264 @@
+/*
+    SymmetryRMSD.hpp
+    ================
+        Symmetry-aware RMSD functions implementation.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <tuple>
+#include <algorithm>
+#include <unordered_map>
+#include <Eigen/Dense>
+#include "Residue.h"
+#include "Atom.h"
+#include "Math.hpp"
+#include "Constants.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::pair;
+using std::tuple;
+using std::tie;
+using std::max;
+using std::unordered_map;
+using Eigen::RowVector3d;
+using Eigen::Matrix3d;
+using Eigen::MatrixX3d;
+using Eigen::VectorXd;
+using Eigen::Ref;
+using Eigen::Array;
+using Eigen::Dynamic;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Symmetric Atom Flips (Atom Index Pairs Of Each Flip, By __RESIDUE_SYMMETRIC_ATOMS_NAME_MAP)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vector<vector<pair<int, int>>> calcSymmetricAtomFlips(const vector<Atom *> &atomPtrList)
+{
+    vector<Residue *> resPtrList;
+    unordered_map<Residue *, unordered_map<string, int>> atomIdxMap;
+
+    for (int atomIdx = 0; atomIdx < (int) atomPtrList.size(); atomIdx++)
+    {
+        auto resPtr = atomPtrList[atomIdx]->owner();
+
+        if (!resPtr || !__RESIDUE_SYMMETRIC_ATOMS_NAME_MAP.count(resPtr->name()))
+        {
+            continue;
+        }
+
+        if (!atomIdxMap.count(resPtr))
+        {
+            resPtrList.push_back(resPtr);
+        }
+
+        atomIdxMap[resPtr].emplace(atomPtrList[atomIdx]->name(), atomIdx);
+    }
+
+    vector<vector<pair<int, int>>> flipList;
+
+    for (auto resPtr: resPtrList)
+    {
+        auto &resAtomIdxMap = atomIdxMap[resPtr];
+
+        for (auto &flipAtomNameList: __RESIDUE_SYMMETRIC_ATOMS_NAME_MAP.at(resPtr->name()))
+        {
+            vector<pair<int, int>> flip;
+
+            for (auto &[atomNameI, atomNameJ]: flipAtomNameList)
+            {
+                if (resAtomIdxMap.count(atomNameI) && resAtomIdxMap.count(atomNameJ))
+                {
+                    flip.emplace_back(resAtomIdxMap[atomNameI], resAtomIdxMap[atomNameJ]);
+                }
+            }
+
+            // A Flip Is Only Valid If All Its Atoms Are Present
+            if (flip.size() == flipAtomNameList.size())
+            {
+                flipList.push_back(flip);
+            }
+        }
+    }
+
+    return flipList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Search Symmetry Flips
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+tuple<RowVector3d, Matrix3d, RowVector3d, Array<bool, Dynamic, 1>, double> __searchSymmetryFlips(
+    const Ref<const MatrixX3d> &tarCoordMatrix, const Ref<const MatrixX3d> &srcCoordMatrix,
+    const vector<vector<pair<int, int>>> &flipList, bool superimposeBool, int maxIter)
+{
+    int flipNum = flipList.size(), pairNum = 0;
+
+    for (auto &flip: flipList)
+    {
+        pairNum += flip.size();
+    }
+
+    MatrixX3d srcDiffMatrix(pairNum, 3), tarDiffMatrix(pairNum, 3);
+    vector<int> pairFlipIdxList(pairNum);
+
+    for (int flipIdx = 0, pairIdx = 0; flipIdx < flipNum; flipIdx++)
+    {
+        for (auto [atomIdxI, atomIdxJ]: flipList[flipIdx])
+        {
+            srcDiffMatrix.row(pairIdx) = srcCoordMatrix.row(atomIdxI) - srcCoordMatrix.row(atomIdxJ);
+            tarDiffMatrix.row(pairIdx) = tarCoordMatrix.row(atomIdxI) - tarCoordMatrix.row(atomIdxJ);
+            pairFlipIdxList[pairIdx++] = flipIdx;
+        }
+    }
+
+    RowVector3d srcCenterCoord = RowVector3d::Zero(), tarCenterCoord = RowVector3d::Zero();
+    Matrix3d rotationMatrix = Matrix3d::Identity(), covMatrix = Matrix3d::Zero();
+    double tarInnerProduct = 0., srcInnerProduct = 0., flipDeviation = 0.;
+
+    if (superimposeBool)
+    {
+        tie(srcCenterCoord, tarCenterCoord, covMatrix, tarInnerProduct, srcInnerProduct) =
+            __calcSuperimposeStatistics(tarCoordMatrix, srcCoordMatrix);
+    }
+
+    Array<bool, Dynamic, 1> flipBoolList = Array<bool, Dynamic, 1>::Constant(flipNum, false);
+
+    for (int iterIdx = 0; iterIdx < maxIter; iterIdx++)
+    {
+        if (superimposeBool)
+        {
+            rotationMatrix = __calcKabschRotationMatrix(covMatrix);
+        }
+
+        // Swapping src_i, src_j Changes The Squared Deviation By 2 * ((src_i - src_j) * R) . (tar_i - tar_j)
+        VectorXd pairGainList = (srcDiffMatrix * rotationMatrix).cwiseProduct(tarDiffMatrix).rowwise().sum();
+        VectorXd flipGainList = VectorXd::Zero(flipNum);
+
+        for (int pairIdx = 0; pairIdx < pairNum; pairIdx++)
+        {
+            flipGainList[pairFlipIdxList[pairIdx]] += pairGainList[pairIdx];
+        }
+
+        bool changeBool = false;
+
+        for (int pairIdx = 0; pairIdx < pairNum; pairIdx++)
+        {
+            if (flipGainList[pairFlipIdxList[pairIdx]] < 0.)
+            {
+                // And The Covariance Matrix By -(src_i - src_j)^T * (tar_i - tar_j)
+                covMatrix -= srcDiffMatrix.row(pairIdx).transpose() * tarDiffMatrix.row(pairIdx);
+                srcDiffMatrix.row(pairIdx) = -srcDiffMatrix.row(pairIdx);
+            }
+        }
+
+        for (int flipIdx = 0; flipIdx < flipNum; flipIdx++)
+        {
+            if (flipGainList[flipIdx] < 0.)
+            {
+                flipBoolList[flipIdx] = !flipBoolList[flipIdx];
+                flipDeviation += 2. * flipGainList[flipIdx];
+                changeBool = true;
+            }
+        }
+
+        // Without Superimpose The Flips Are Independent, One Pass Is Exact
+        if (!changeBool || !superimposeBool)
+        {
+            break;
+        }
+    }
+
+    double squaredDeviation;
+
+    if (superimposeBool)
+    {
+        rotationMatrix = __calcKabschRotationMatrix(covMatrix);
+
+        squaredDeviation = tarInnerProduct + srcInnerProduct - 2. * rotationMatrix.cwiseProduct(covMatrix).sum();
+    }
+    else
+    {
+        squaredDeviation = (tarCoordMatrix - srcCoordMatrix).squaredNorm() + flipDeviation;
+    }
+
+    return {srcCenterCoord, rotationMatrix, tarCenterCoord, flipBoolList, max(squaredDeviation, 0.)};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Symmetry RMSD (Without Superimpose)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double calcSymmetryRMSD(const Ref<const MatrixX3d> &tarCoordMatrix, const Ref<const MatrixX3d> &srcCoordMatrix,
+    const vector<vector<pair<int, int>>> &flipList)
+{
+    auto [srcCenterCoord, rotationMatrix, tarCenterCoord, flipBoolList, squaredDeviation] =
+        __searchSymmetryFlips(tarCoordMatrix, srcCoordMatrix, flipList, false, 1);
+
+    return sqrt(squaredDeviation / tarCoordMatrix.rows());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Symmetry Superimpose Rotation Matrix (src.row(atomIdxList[i]) Matches tar.row(i))
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+tuple<RowVector3d, Matrix3d, RowVector3d, vector<int>> calcSymmetrySuperimposeRotationMatrix(
+    const Ref<const MatrixX3d> &tarCoordMatrix, const Ref<const MatrixX3d> &srcCoordMatrix,
+    const vector<vector<pair<int, int>>> &flipList, int maxIter = 10)
+{
+    auto [srcCenterCoord, rotationMatrix, tarCenterCoord, flipBoolList, squaredDeviation] =
+        __searchSymmetryFlips(tarCoordMatrix, srcCoordMatrix, flipList, true, maxIter);
+
+    vector<int> atomIdxList(srcCoordMatrix.rows());
+
+    for (int atomIdx = 0; atomIdx < (int) atomIdxList.size(); atomIdx++)
+    {
+        atomIdxList[atomIdx] = atomIdx;
+    }
+
+    for (int flipIdx = 0; flipIdx < (int) flipList.size(); flipIdx++)
+    {
+        if (flipBoolList[flipIdx])
+        {
+            for (auto [atomIdxI, atomIdxJ]: flipList[flipIdx])
+            {
+                atomIdxList[atomIdxI] = atomIdxJ;
+                atomIdxList[atomIdxJ] = atomIdxI;
+            }
+        }
+    }
+
+    return {srcCenterCoord, rotationMatrix, tarCenterCoord, atomIdxList};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Symmetry RMSD After Superimpose A <= B
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double calcSymmetryRMSDAfterSuperimpose(const Ref<const MatrixX3d> &tarCoordMatrix,
+    const Ref<const MatrixX3d> &srcCoordMatrix, const vector<vector<pair<int, int>>> &flipList, int maxIter = 10)
+{
+    auto [srcCenterCoord, rotationMatrix, tarCenterCoord, flipBoolList, squaredDeviation] =
+        __searchSymmetryFlips(tarCoordMatrix, srcCoordMatrix, flipList, true, maxIter);
+
+    return sqrt(squaredDeviation / tarCoordMatrix.rows());
+}
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,405 @@
+/*
+    TMScore.hpp
+    ===========
+        TM-score and GDT functions implementation.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <tuple>
+#include <stdexcept>
+#include <boost/format.hpp>
+#include <Eigen/Dense>
+#include "Math.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::vector;
+using std::min;
+using std::max;
+using std::pair;
+using std::tuple;
+using std::get;
+using std::cbrt;
+using std::runtime_error;
+using boost::format;
+using Eigen::RowVector3d;
+using Eigen::Matrix3d;
+using Eigen::MatrixX3d;
+using Eigen::VectorXd;
+using Eigen::ArrayXd;
+using Eigen::Array;
+using Eigen::Dynamic;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Superimpose Search Constants (Zhang & Skolnick, 2004)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const int __SUPERIMPOSE_SEARCH_MIN_FRAGMENT_LEN = 4;
+const int __SUPERIMPOSE_SEARCH_MAX_FRAGMENT_NUM = 6;
+const int __SUPERIMPOSE_SEARCH_MAX_ITER         = 20;
+const int __SUPERIMPOSE_SEARCH_MIN_SELECT_NUM   = 3;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Superimpose Search Cache
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct __SuperimposeSearchCache
+{
+    RowVector3d tarMeanCoord;
+    RowVector3d srcMeanCoord;
+    MatrixX3d tarCoordMatrix;
+    MatrixX3d srcCoordMatrix;
+    MatrixX3d tarPrefixSumMatrix;
+    MatrixX3d srcPrefixSumMatrix;
+    vector<Matrix3d> covPrefixSumList;
+    vector<pair<int, int>> seedList;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Build Superimpose Search Cache
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+__SuperimposeSearchCache __buildSuperimposeSearchCache(const MatrixX3d &tarCoordMatrix,
+    const MatrixX3d &srcCoordMatrix, int seedStep = 1)
+{
+    if (tarCoordMatrix.rows() != srcCoordMatrix.rows())
+    {
+        throw runtime_error((format("Coord matrix size mismatch: %d vs %d") %
+            tarCoordMatrix.rows() % srcCoordMatrix.rows()).str());
+    }
+
+    int resNum = tarCoordMatrix.rows();
+
+    // Centered Copies Keep The Prefix Sums Small, So Fragment Covariances Lose No Precision
+    RowVector3d tarMeanCoord = tarCoordMatrix.colwise().mean();
+    RowVector3d srcMeanCoord = srcCoordMatrix.colwise().mean();
+
+    __SuperimposeSearchCache cacheObj {
+        tarMeanCoord, srcMeanCoord,
+        tarCoordMatrix.rowwise() - tarMeanCoord, srcCoordMatrix.rowwise() - srcMeanCoord,
+        MatrixX3d::Zero(resNum + 1, 3), MatrixX3d::Zero(resNum + 1, 3),
+        vector<Matrix3d>(resNum + 1, Matrix3d::Zero()), {}
+    };
+
+    for (int resIdx = 0; resIdx < resNum; resIdx++)
+    {
+        cacheObj.tarPrefixSumMatrix.row(resIdx + 1) = cacheObj.tarPrefixSumMatrix.row(resIdx) +
+            cacheObj.tarCoordMatrix.row(resIdx);
+
+        cacheObj.srcPrefixSumMatrix.row(resIdx + 1) = cacheObj.srcPrefixSumMatrix.row(resIdx) +
+            cacheObj.srcCoordMatrix.row(resIdx);
+
+        cacheObj.covPrefixSumList[resIdx + 1] = cacheObj.covPrefixSumList[resIdx] +
+            cacheObj.srcCoordMatrix.row(resIdx).transpose() * cacheObj.tarCoordMatrix.row(resIdx);
+    }
+
+    // Fragment Lengths L, L / 2, L / 4, ..., Down To The Minimum, Start Positions seedStep Apart
+    vector<int> fragmentLenList;
+
+    for (int fragmentLen = resNum; fragmentLen > 0; fragmentLen /= 2)
+    {
+        if (fragmentLen <= __SUPERIMPOSE_SEARCH_MIN_FRAGMENT_LEN ||
+            fragmentLenList.size() == __SUPERIMPOSE_SEARCH_MAX_FRAGMENT_NUM - 1)
+        {
+            fragmentLenList.push_back(min(resNum, __SUPERIMPOSE_SEARCH_MIN_FRAGMENT_LEN));
+            break;
+        }
+
+        fragmentLenList.push_back(fragmentLen);
+    }
+
+    for (int fragmentLen: fragmentLenList)
+    {
+        for (int startIdx = 0; startIdx + fragmentLen <= resNum; startIdx += seedStep)
+        {
+            cacheObj.seedList.emplace_back(startIdx, fragmentLen);
+        }
+
+        // Always Seed The Last Fragment
+        if ((resNum - fragmentLen) % seedStep)
+        {
+            cacheObj.seedList.emplace_back(resNum - fragmentLen, fragmentLen);
+        }
+    }
+
+    return cacheObj;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Refine Superimpose Score (Iterative Kabsch On The Residues Within selectCutoff)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Func>
+tuple<double, RowVector3d, Matrix3d, RowVector3d> __refineSuperimposeScore(const __SuperimposeSearchCache &cacheObj,
+    RowVector3d srcCenterCoord, Matrix3d rotationMatrix, RowVector3d tarCenterCoord, double selectCutoff,
+    Func &&scoreFunc)
+{
+    const MatrixX3d &tarCoordMatrix = cacheObj.tarCoordMatrix;
+    const MatrixX3d &srcCoordMatrix = cacheObj.srcCoordMatrix;
+
+    int minSelectNum = min((int)tarCoordMatrix.rows(), __SUPERIMPOSE_SEARCH_MIN_SELECT_NUM);
+
+    tuple<double, RowVector3d, Matrix3d, RowVector3d> maxScoreTuple {-1., srcCenterCoord, rotationMatrix,
+        tarCenterCoord};
+    Array<bool, Dynamic, 1> lastSelectBoolList;
+
+    for (int iterIdx = 0; ; iterIdx++)
+    {
+        ArrayXd squaredDisList = ((((srcCoordMatrix.rowwise() - srcCenterCoord) * rotationMatrix).rowwise() +
+            tarCenterCoord) - tarCoordMatrix).rowwise().squaredNorm().array();
+
+        double score = scoreFunc(squaredDisList);
+
+        if (score > get<0>(maxScoreTuple))
+        {
+            maxScoreTuple = {score, srcCenterCoord, rotationMatrix, tarCenterCoord};
+        }
+
+        if (iterIdx == __SUPERIMPOSE_SEARCH_MAX_ITER)
+        {
+            break;
+        }
+
+        // Too Few Residues Within The Cutoff: Relax It Until A Superposition Is Defined
+        double cutoff = selectCutoff;
+        Array<bool, Dynamic, 1> selectBoolList = squaredDisList < cutoff * cutoff;
+
+        while (selectBoolList.count() < minSelectNum)
+        {
+            cutoff += 0.5;
+            selectBoolList = squaredDisList < cutoff * cutoff;
+        }
+
+        if (iterIdx > 0 && (selectBoolList == lastSelectBoolList).all())
+        {
+            break;
+        }
+
+        lastSelectBoolList = selectBoolList;
+
+        ArrayXd weightList = selectBoolList.cast<double>();
+        double selectNum = weightList.sum();
+
+        srcCenterCoord = (weightList.matrix().transpose() * srcCoordMatrix) / selectNum;
+        tarCenterCoord = (weightList.matrix().transpose() * tarCoordMatrix) / selectNum;
+
+        rotationMatrix = __calcKabschRotationMatrix(
+            srcCoordMatrix.transpose().lazyProduct((tarCoordMatrix.array().colwise() * weightList).matrix()) -
+            selectNum * srcCenterCoord.transpose() * tarCenterCoord);
+    }
+
+    return maxScoreTuple;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Search Superimpose Score (Max Over All Seed Fragments)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Func>
+tuple<double, RowVector3d, Matrix3d, RowVector3d> __searchSuperimposeScore(const __SuperimposeSearchCache &cacheObj,
+    double selectCutoff, Func &&scoreFunc)
+{
+    int seedNum = cacheObj.seedList.size();
+
+    if (seedNum == 0)
+    {
+        return {0., RowVector3d::Zero(), Matrix3d::Identity(), RowVector3d::Zero()};
+    }
+
+    vector<tuple<double, RowVector3d, Matrix3d, RowVector3d>> seedScoreTupleList(seedNum);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int seedIdx = 0; seedIdx < seedNum; seedIdx++)
+    {
+        auto [startIdx, fragmentLen] = cacheObj.seedList[seedIdx];
+
+        int endIdx = startIdx + fragmentLen;
+
+        // Seed Superposition From The Prefix Sums: O(1) Per Fragment
+        RowVector3d srcCenterCoord = (cacheObj.srcPrefixSumMatrix.row(endIdx) -
+            cacheObj.srcPrefixSumMatrix.row(startIdx)) / fragmentLen;
+
+        RowVector3d tarCenterCoord = (cacheObj.tarPrefixSumMatrix.row(endIdx) -
+            cacheObj.tarPrefixSumMatrix.row(startIdx)) / fragmentLen;
+
+        Matrix3d rotationMatrix = __calcKabschRotationMatrix(cacheObj.covPrefixSumList[endIdx] -
+            cacheObj.covPrefixSumList[startIdx] - fragmentLen * srcCenterCoord.transpose() * tarCenterCoord);
+
+        seedScoreTupleList[seedIdx] = __refineSuperimposeScore(cacheObj, srcCenterCoord, rotationMatrix,
+            tarCenterCoord, selectCutoff, scoreFunc);
+    }
+
+    int maxSeedIdx = 0;
+
+    for (int seedIdx = 1; seedIdx < seedNum; seedIdx++)
+    {
+        if (get<0>(seedScoreTupleList[seedIdx]) > get<0>(seedScoreTupleList[maxSeedIdx]))
+        {
+            maxSeedIdx = seedIdx;
+        }
+    }
+
+    // Back From The Centered Frames
+    auto [maxScore, srcCenterCoord, rotationMatrix, tarCenterCoord] = seedScoreTupleList[maxSeedIdx];
+
+    return {maxScore, srcCenterCoord + cacheObj.srcMeanCoord, rotationMatrix, tarCenterCoord + cacheObj.tarMeanCoord};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc TM-Score d0
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double __calcTMScoreD0(int resNum)
+{
+    return max(0.5, 1.24 * cbrt(resNum - 15.) - 1.8);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc TM-Score A <= B (Normalized By The Length Of A)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double calcTMScore(const MatrixX3d &tarCoordMatrix, const MatrixX3d &srcCoordMatrix, double d0 = 0.)
+{
+    auto cacheObj = __buildSuperimposeSearchCache(tarCoordMatrix, srcCoordMatrix);
+
+    int resNum = tarCoordMatrix.rows();
+
+    if (d0 <= 0.)
+    {
+        d0 = __calcTMScoreD0(resNum);
+    }
+
+    double squaredD0 = d0 * d0;
+
+    return get<0>(__searchSuperimposeScore(cacheObj, min(max(d0, 4.5), 8.), [=](const ArrayXd &squaredDisList)
+    {
+        return (1. / (1. + squaredDisList / squaredD0)).sum() / resNum;
+    }));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc GDT (Mean Over Cutoffs Of The Max Fraction Within Each Cutoff)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double __calcGDT(const MatrixX3d &tarCoordMatrix, const MatrixX3d &srcCoordMatrix, const vector<double> &cutoffList)
+{
+    auto cacheObj = __buildSuperimposeSearchCache(tarCoordMatrix, srcCoordMatrix);
+
+    int resNum = tarCoordMatrix.rows();
+
+    double gdtScore = 0.;
+
+    for (double cutoff: cutoffList)
+    {
+        double squaredCutoff = cutoff * cutoff;
+
+        gdtScore += get<0>(__searchSuperimposeScore(cacheObj, cutoff, [=](const ArrayXd &squaredDisList)
+        {
+            return (squaredDisList < squaredCutoff).count() / (double)resNum;
+        }));
+    }
+
+    return gdtScore / cutoffList.size();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc GDT-TS A <= B (Cutoffs 1, 2, 4, 8)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double calcGDTTS(const MatrixX3d &tarCoordMatrix, const MatrixX3d &srcCoordMatrix)
+{
+    return __calcGDT(tarCoordMatrix, srcCoordMatrix, {1., 2., 4., 8.});
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc GDT-HA A <= B (Cutoffs 0.5, 1, 2, 4)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double calcGDTHA(const MatrixX3d &tarCoordMatrix, const MatrixX3d &srcCoordMatrix)
+{
+    return __calcGDT(tarCoordMatrix, srcCoordMatrix, {0.5, 1., 2., 4.});
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc TM-Score List (One-vs-Many)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorXd calcTMScoreList(const MatrixX3d &tarCoordMatrix, const vector<MatrixX3d> &srcCoordMatrixList, double d0 = 0.)
+{
+    int modelNum = srcCoordMatrixList.size();
+
+    VectorXd scoreList(modelNum);
+
+    // Nested Regions Run Serially, So Each Thread Scores Whole Models
+    #pragma omp parallel for schedule(dynamic)
+    for (int modelIdx = 0; modelIdx < modelNum; modelIdx++)
+    {
+        scoreList[modelIdx] = calcTMScore(tarCoordMatrix, srcCoordMatrixList[modelIdx], d0);
+    }
+
+    return scoreList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc GDT-TS List (One-vs-Many)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorXd calcGDTTSList(const MatrixX3d &tarCoordMatrix, const vector<MatrixX3d> &srcCoordMatrixList)
+{
+    int modelNum = srcCoordMatrixList.size();
+
+    VectorXd scoreList(modelNum);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int modelIdx = 0; modelIdx < modelNum; modelIdx++)
+    {
+        scoreList[modelIdx] = calcGDTTS(tarCoordMatrix, srcCoordMatrixList[modelIdx]);
+    }
+
+    return scoreList;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc GDT-HA List (One-vs-Many)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorXd calcGDTHAList(const MatrixX3d &tarCoordMatrix, const vector<MatrixX3d> &srcCoordMatrixList)
+{
+    int modelNum = srcCoordMatrixList.size();
+
+    VectorXd scoreList(modelNum);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int modelIdx = 0; modelIdx < modelNum; modelIdx++)
+    {
+        scoreList[modelIdx] = calcGDTHA(tarCoordMatrix, srcCoordMatrixList[modelIdx]);
+    }
+
+    return scoreList;
+}
+
+
+}  // End namespace PDBTools
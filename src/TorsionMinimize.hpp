@@ -0,0 +1,194 @@
+/*
+    TorsionMinimize.hpp
+    ===================
+        Torsion space energy minimization functions implementation.
+*/
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+#include <Eigen/Dense>
+#include "InternalChain.h"
+#include "CellList.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::vector;
+using std::pair;
+using std::function;
+using std::min;
+using Eigen::RowVector3d;
+using Eigen::MatrixX3d;
+using Eigen::VectorXd;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// L-BFGS Parameters
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const int __LBFGS_MEMORY_NUM = 10;
+const int __LBFGS_MAX_LINE_SEARCH_NUM = 20;
+
+// Sufficient Decrease (Armijo) Ratio Of The Backtracking Line Search
+const double __LBFGS_ARMIJO_RATIO = 1e-4;
+
+// Largest Torsion Change Of A Single Step (Radian)
+const double __LBFGS_MAX_STEP = 0.2;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Pair Energy And Gradient (pairFunc(atomIdxI, atomIdxJ, dis) Returns (E, dE / dDis))
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+pair<double, MatrixX3d> __calcPairEnergyAndGradient(const MatrixX3d &coordMatrix,
+    const function<pair<double, double>(int, int, double)> &pairFunc, double cutoff)
+{
+    double energyVal = 0.;
+    MatrixX3d coordGradMatrix = MatrixX3d::Zero(coordMatrix.rows(), 3);
+
+    CellList(coordMatrix, cutoff).forEachPair(cutoff, [&](int atomIdxI, int atomIdxJ, double dis)
+    {
+        auto [pairEnergy, pairGrad] = pairFunc(atomIdxI, atomIdxJ, dis);
+
+        energyVal += pairEnergy;
+
+        if (dis > 0.)
+        {
+            RowVector3d disGrad = (coordMatrix.row(atomIdxI) - coordMatrix.row(atomIdxJ)) * (pairGrad / dis);
+
+            coordGradMatrix.row(atomIdxI) += disGrad;
+            coordGradMatrix.row(atomIdxJ) -= disGrad;
+        }
+    });
+
+    return {energyVal, coordGradMatrix};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Minimize Torsion Energy (L-BFGS Over InternalChain::getTorsions, Returns The Final Energy)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double minimizeTorsionEnergy(InternalChain &icObj, const function<pair<double, double>(int, int, double)> &pairFunc,
+    double cutoff, int maxIter = 200, double gradTol = 1e-3)
+{
+    auto evalFunc = [&](const VectorXd &torsionList, VectorXd &torsionGradList)
+    {
+        icObj.setTorsions(torsionList);
+
+        auto [energyVal, coordGradMatrix] = __calcPairEnergyAndGradient(icObj.getAtomsCoord(), pairFunc, cutoff);
+
+        torsionGradList = icObj.calcTorsionGradient(coordGradMatrix);
+
+        return energyVal;
+    };
+
+    VectorXd torsionList = icObj.getTorsions(), torsionGradList;
+    double energyVal = evalFunc(torsionList, torsionGradList);
+
+    vector<VectorXd> stepList, gradDiffList;
+    vector<double> rhoList;
+
+    for (int iterIdx = 0; iterIdx < maxIter && torsionGradList.size(); iterIdx++)
+    {
+        if (torsionGradList.cwiseAbs().maxCoeff() <= gradTol)
+        {
+            break;
+        }
+
+        // Two-Loop Recursion
+        VectorXd dirList = torsionGradList;
+        vector<double> alphaList(stepList.size());
+
+        for (int histIdx = stepList.size() - 1; histIdx >= 0; histIdx--)
+        {
+            alphaList[histIdx] = rhoList[histIdx] * stepList[histIdx].dot(dirList);
+            dirList -= alphaList[histIdx] * gradDiffList[histIdx];
+        }
+
+        if (!stepList.empty())
+        {
+            dirList *= stepList.back().dot(gradDiffList.back()) / gradDiffList.back().squaredNorm();
+        }
+
+        for (int histIdx = 0; histIdx < (int) stepList.size(); histIdx++)
+        {
+            dirList += (alphaList[histIdx] - rhoList[histIdx] * gradDiffList[histIdx].dot(dirList)) *
+                stepList[histIdx];
+        }
+
+        dirList = -dirList;
+
+        // Not A Descent Direction: Restart From Steepest Descent
+        if (dirList.dot(torsionGradList) >= 0.)
+        {
+            dirList = -torsionGradList;
+
+            stepList.clear();
+            gradDiffList.clear();
+            rhoList.clear();
+        }
+
+        dirList *= min(1., __LBFGS_MAX_STEP / dirList.cwiseAbs().maxCoeff());
+
+        // Backtracking Line Search
+        double slopeVal = dirList.dot(torsionGradList), stepRatio = 1.;
+        bool acceptBool = false;
+
+        VectorXd newTorsionList, newTorsionGradList;
+        double newEnergyVal;
+
+        for (int searchIdx = 0; searchIdx < __LBFGS_MAX_LINE_SEARCH_NUM; searchIdx++, stepRatio /= 2.)
+        {
+            newTorsionList = torsionList + stepRatio * dirList;
+            newEnergyVal   = evalFunc(newTorsionList, newTorsionGradList);
+
+            if (newEnergyVal <= energyVal + __LBFGS_ARMIJO_RATIO * stepRatio * slopeVal)
+            {
+                acceptBool = true;
+                break;
+            }
+        }
+
+        if (!acceptBool)
+        {
+            icObj.setTorsions(torsionList);
+            break;
+        }
+
+        VectorXd stepDiff = newTorsionList - torsionList, gradDiff = newTorsionGradList - torsionGradList;
+
+        // Keep Only Curvature Pairs That Keep The Inverse Hessian Positive Definite
+        if (stepDiff.dot(gradDiff) > 1e-10)
+        {
+            if (stepList.size() == __LBFGS_MEMORY_NUM)
+            {
+                stepList.erase(stepList.begin());
+                gradDiffList.erase(gradDiffList.begin());
+                rhoList.erase(rhoList.begin());
+            }
+
+            stepList.push_back(stepDiff);
+            gradDiffList.push_back(gradDiff);
+            rhoList.push_back(1. / stepDiff.dot(gradDiff));
+        }
+
+        torsionList     = newTorsionList;
+        torsionGradList = newTorsionGradList;
+        energyVal       = newEnergyVal;
+    }
+
+    return energyVal;
+}
+
+
+}  // End namespace PDBTools
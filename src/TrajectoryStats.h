@@ -0,0 +1,96 @@
+/*
+    TrajectoryStats.h
+    =================
+        Class TrajectoryStats header.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <Eigen/Dense>
+#include "Predecl.h"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::ostream;
+using Eigen::MatrixX3d;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+using Eigen::Matrix;
+using Eigen::Dynamic;
+using Eigen::RowMajor;
+using Eigen::Ref;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Class TrajectoryStats
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class TrajectoryStats
+{
+    // Friend
+    friend ostream &operator<<(ostream &os, const TrajectoryStats &trajStatsObj);
+
+
+public:
+
+    // Constructor
+    explicit TrajectoryStats(const MatrixX3d &refCoordMatrix, bool covBool = false);
+
+
+    // Getter: __refCoordMatrix
+    const MatrixX3d &refCoordMatrix() const;
+
+
+    // Getter: __modelNum
+    int modelNum() const;
+
+
+    // Getter: __meanCoordMatrix
+    const MatrixX3d &meanCoordMatrix() const;
+
+
+    // Append
+    TrajectoryStats *append(const Ref<const MatrixX3d> &coordMatrix);
+
+
+    // Calc RMSF
+    VectorXd calcRMSF() const;
+
+
+    // Calc Covariance Matrix
+    MatrixXd calcCovMatrix() const;
+
+
+    // Dump RMSF To tempF
+    TrajectoryStats *dumpRMSFToTempF(const vector<Atom *> &atomPtrList, bool residueBool = true);
+
+
+private:
+
+    // Data
+    MatrixX3d __refCoordMatrix;
+    bool __covBool;
+    int __modelNum;
+    MatrixX3d __meanCoordMatrix;
+    VectorXd __squaredDeviationSumList;
+    MatrixXd __covSumMatrix;
+    MatrixX3d __fitCoordMatrix;
+    Matrix<double, Dynamic, 3, RowMajor> __deltaMatrix;
+
+
+    // str
+    string __str() const;
+};
+
+
+}  // End namespace PDBTools
@@ -0,0 +1,245 @@
+/*
+    TrajectoryStats.hpp
+    ===================
+        Class TrajectoryStats implementation.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <boost/format.hpp>
+#include <Eigen/Dense>
+#include "TrajectoryStats.h"
+#include "Residue.h"
+#include "Atom.h"
+#include "Math.hpp"
+
+namespace PDBTools
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Using
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using std::string;
+using std::vector;
+using std::unordered_map;
+using std::pair;
+using std::min;
+using std::runtime_error;
+using boost::format;
+using Eigen::RowVector3d;
+using Eigen::Matrix3d;
+using Eigen::MatrixX3d;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+using Eigen::Map;
+using Eigen::Lower;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constructor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TrajectoryStats::TrajectoryStats(const MatrixX3d &refCoordMatrix, bool covBool):
+    __refCoordMatrix(refCoordMatrix),
+    __covBool(covBool),
+    __modelNum(0),
+    __meanCoordMatrix(MatrixX3d::Zero(refCoordMatrix.rows(), 3)),
+    __squaredDeviationSumList(VectorXd::Zero(refCoordMatrix.rows())),
+    __covSumMatrix(covBool ? MatrixXd::Zero(refCoordMatrix.rows() * 3, refCoordMatrix.rows() * 3) : MatrixXd()),
+    __fitCoordMatrix(refCoordMatrix.rows(), 3),
+    __deltaMatrix(refCoordMatrix.rows(), 3) {}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __refCoordMatrix
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const MatrixX3d &TrajectoryStats::refCoordMatrix() const
+{
+    return __refCoordMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __modelNum
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int TrajectoryStats::modelNum() const
+{
+    return __modelNum;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Getter: __meanCoordMatrix
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const MatrixX3d &TrajectoryStats::meanCoordMatrix() const
+{
+    return __meanCoordMatrix;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Append (Superimpose Onto The Reference, Then Welford Update)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TrajectoryStats *TrajectoryStats::append(const Ref<const MatrixX3d> &coordMatrix)
+{
+    if (coordMatrix.rows() != __refCoordMatrix.rows())
+    {
+        throw runtime_error((format("Coord matrix size mismatch: %d vs %d") %
+            __refCoordMatrix.rows() % coordMatrix.rows()).str());
+    }
+
+    auto [srcCenterCoord, rotationMatrix, tarCenterCoord] =
+        calcSuperimposeRotationMatrix(__refCoordMatrix, coordMatrix);
+
+    __fitCoordMatrix.noalias() = (coordMatrix.rowwise() - srcCenterCoord) * rotationMatrix;
+    __fitCoordMatrix.rowwise() += tarCenterCoord;
+
+    __modelNum++;
+
+    // x - mean(n) = (n - 1) / n * (x - mean(n - 1))
+    double updateWeight = (__modelNum - 1.) / __modelNum;
+
+    __deltaMatrix = __fitCoordMatrix - __meanCoordMatrix;
+    __meanCoordMatrix += __deltaMatrix / __modelNum;
+    __squaredDeviationSumList += updateWeight * __deltaMatrix.rowwise().squaredNorm();
+
+    if (__covBool)
+    {
+        // Atom-Major Flattening (x1, y1, z1, x2, ...), Lower Triangle Only
+        __covSumMatrix.selfadjointView<Lower>().rankUpdate(
+            Map<const VectorXd>(__deltaMatrix.data(), __deltaMatrix.size()), updateWeight);
+    }
+
+    return this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc RMSF (Root-Mean-Square Fluctuation About The Mean Structure)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorXd TrajectoryStats::calcRMSF() const
+{
+    if (!__modelNum)
+    {
+        return VectorXd::Zero(__refCoordMatrix.rows());
+    }
+
+    return (__squaredDeviationSumList / __modelNum).cwiseSqrt();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Calc Covariance Matrix (3N * 3N, Atom-Major)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MatrixXd TrajectoryStats::calcCovMatrix() const
+{
+    if (!__covBool)
+    {
+        throw runtime_error("Covariance matrix is not accumulated (covBool = false)");
+    }
+
+    if (!__modelNum)
+    {
+        return __covSumMatrix;
+    }
+
+    MatrixXd covMatrix = __covSumMatrix.selfadjointView<Lower>();
+
+    return covMatrix / __modelNum;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Dump RMSF To tempF
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TrajectoryStats *TrajectoryStats::dumpRMSFToTempF(const vector<Atom *> &atomPtrList, bool residueBool)
+{
+    if ((int) atomPtrList.size() != __refCoordMatrix.rows())
+    {
+        throw runtime_error((format("Atom number mismatch: %d atoms vs %d rows") %
+            atomPtrList.size() % __refCoordMatrix.rows()).str());
+    }
+
+    auto rmsfList = calcRMSF();
+
+    // The tempF Column Is 6 Characters Wide
+    auto tempFFunc = [](double rmsfValue)
+    {
+        return (format("%.2f") % min(rmsfValue, 999.99)).str();
+    };
+
+    if (!residueBool)
+    {
+        for (int atomIdx = 0; atomIdx < (int) atomPtrList.size(); atomIdx++)
+        {
+            atomPtrList[atomIdx]->tempF(tempFFunc(rmsfList[atomIdx]));
+        }
+
+        return this;
+    }
+
+    vector<Residue *> resPtrList;
+    unordered_map<Residue *, pair<double, int>> rmsfSumMap;
+
+    for (int atomIdx = 0; atomIdx < (int) atomPtrList.size(); atomIdx++)
+    {
+        auto resPtr = atomPtrList[atomIdx]->owner();
+
+        if (!resPtr)
+        {
+            atomPtrList[atomIdx]->tempF(tempFFunc(rmsfList[atomIdx]));
+
+            continue;
+        }
+
+        if (!rmsfSumMap.count(resPtr))
+        {
+            resPtrList.push_back(resPtr);
+        }
+
+        rmsfSumMap[resPtr].first += rmsfList[atomIdx];
+        rmsfSumMap[resPtr].second++;
+    }
+
+    // Every Atom Of The Residue Gets The Residue Mean, Not Only The Atoms Used For The Statistics
+    for (auto resPtr: resPtrList)
+    {
+        auto [rmsfSum, atomNum] = rmsfSumMap[resPtr];
+
+        for (auto atomPtr: resPtr->sub())
+        {
+            atomPtr->tempF(tempFFunc(rmsfSum / atomNum));
+        }
+    }
+
+    return this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// str
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string TrajectoryStats::__str() const
+{
+    return (format("<TrajectoryStats object: %d atoms, %d models, at %p>") %
+        __refCoordMatrix.rows() % __modelNum % this).str();
+}
+
+
+}  // End namespace PDBTools
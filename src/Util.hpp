@@ -13,10 +13,22 @@
 #include <cstdio>
 #include <cstdint>
 #include <utility>
+#include <cctype>
 #include "Protein.h"
 #include "Chain.h"
 #include "Residue.h"
 #include "Atom.h"
+#include "InternalChain.h"
+#include "CellList.h"
+#include "KDTree.h"
+#include "ClashChecker.h"
+#include "EnergyScorer.h"
+#include "ScoreTracker.h"
+#include "AtomTable.h"
+#include "Selection.h"
+#include "ModelReader.h"
+#include "TrajectoryStats.h"
+#include "PCA.h"
 #include "Constants.hpp"
 
 namespace PDBTools
@@ -32,6 +44,8 @@ using std::vector;
 using std::ostream;
 using std::from_chars;
 using std::pair;
+using std::isalpha;
+using std::toupper;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -74,6 +88,116 @@ ostream &operator<<(ostream &os, const Atom &atomObj)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// operator<< (InternalChain)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ostream &operator<<(ostream &os, const InternalChain &icObj)
+{
+    return os << icObj.__str();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// operator<< (CellList)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ostream &operator<<(ostream &os, const CellList &cellListObj)
+{
+    return os << cellListObj.__str();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// operator<< (KDTree)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ostream &operator<<(ostream &os, const KDTree &kdTreeObj)
+{
+    return os << kdTreeObj.__str();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// operator<< (ClashChecker)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ostream &operator<<(ostream &os, const ClashChecker &clashCheckerObj)
+{
+    return os << clashCheckerObj.__str();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// operator<< (AtomTable)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ostream &operator<<(ostream &os, const AtomTable &atomTableObj)
+{
+    return os << atomTableObj.__str();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// operator<< (Selection)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ostream &operator<<(ostream &os, const Selection &selObj)
+{
+    return os << selObj.__str();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// operator<< (ModelReader)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ostream &operator<<(ostream &os, const ModelReader &modelReaderObj)
+{
+    return os << modelReaderObj.__str();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// operator<< (TrajectoryStats)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ostream &operator<<(ostream &os, const TrajectoryStats &trajStatsObj)
+{
+    return os << trajStatsObj.__str();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// operator<< (PCA)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ostream &operator<<(ostream &os, const PCA &pcaObj)
+{
+    return os << pcaObj.__str();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// operator<< (EnergyScorer)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ostream &operator<<(ostream &os, const EnergyScorer &energyScorerObj)
+{
+    return os << energyScorerObj.__str();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// operator<< (ScoreTracker)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ostream &operator<<(ostream &os, const ScoreTracker &scoreTrackerObj)
+{
+    return os << scoreTrackerObj.__str();
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Is H
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -181,4 +305,48 @@ void dumpFasta(const T &structPtrList, const string &dumpFilePath, const string
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Element (Element Column First, Then The First Letter Of The Atom Name)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+string getElement(Atom *atomPtr)
+{
+    string eleStr;
+
+    for (char eleChar: atomPtr->ele())
+    {
+        if (isalpha(eleChar))
+        {
+            eleStr += toupper(eleChar);
+        }
+    }
+
+    if (eleStr.empty())
+    {
+        for (char nameChar: atomPtr->name())
+        {
+            if (isalpha(nameChar))
+            {
+                eleStr = toupper(nameChar);
+                break;
+            }
+        }
+    }
+
+    return eleStr;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Get Van Der Waals Radius
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double getVdwRadius(Atom *atomPtr)
+{
+    auto radiusIter = ELEMENT_VDW_RADIUS_MAP.find(getElement(atomPtr));
+
+    return radiusIter == ELEMENT_VDW_RADIUS_MAP.end() ? __DEFAULT_VDW_RADIUS : radiusIter->second;
+}
+
+
 }  // End namespace PDBTools